@@ -0,0 +1,15 @@
+#ifndef BENCH_UTIL
+#define BENCH_UTIL
+
+#include <chrono>
+
+// Wall clock seconds spent in f()
+template<class F>
+double time_seconds(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench_util.h"
+#include "two_edge_connected.h"
+
+// Usage: connected_bench [vertices] [edges] [queries] [random|path]
+// Builds a random graph, or a path linked in order, and compares connected, which splays
+// the leaves of the vertices and compares the roots above them, with exposing both
+// vertices as connected used to. The latter runs the TwoEdgeCluster split and merge over
+// both root paths twice each. The path starts out as deep as it gets, the random graphs
+// are shallow.
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    int m = argc > 2 ? atoi(argv[2]) : n;
+    int queries = argc > 3 ? atoi(argv[3]) : 1000000;
+    std::string shape = argc > 4 ? argv[4] : "random";
+
+    std::mt19937 rng(42);
+    TwoEdgeConnectivity<20> graph = TwoEdgeConnectivity<20>(n);
+    if (shape == "path") {
+        m = n - 1;
+        for (int i = 0; i + 1 < n; i++) {
+            graph.insert(i, i + 1);
+        }
+    } else {
+        for (int i = 0; i < m; i++) {
+            int u = rng() % n;
+            int v = rng() % n;
+            if (u != v) {
+                graph.insert(u, v);
+            }
+        }
+    }
+    std::vector<std::pair<int,int>> asked;
+    for (int i = 0; i < queries; i++) {
+        asked.push_back({ (int) (rng() % n), (int) (rng() % n) });
+    }
+
+    std::cout << shape << " n=" << n << " m=" << m << " queries=" << queries << std::endl;
+    int answers[2] = { 0, 0 };
+    double structural = time_seconds([&]() {
+        for (auto& [u, v] : asked) {
+            answers[1] += graph.connected(u, v);
+        }
+    });
+    double exposing = time_seconds([&]() {
+        for (auto& [u, v] : asked) {
+            if (u == v) {
+                answers[0]++;
+                continue;
+            }
+            // With both exposed, the root of v's tree has two boundary vertices if u is in it.
+            graph.expose(u);
+            TwoEdgeCluster<20>* root = graph.expose(v);
+            answers[0] += root && root->get_num_boundary_vertices() == 2;
+            graph.deexpose(u);
+            graph.deexpose(v);
+        }
+    });
+    std::cout << "expose-queries/s " << queries / exposing << " structural-queries/s " << queries / structural << std::endl;
+    std::cout << "connected " << answers[0] << " " << answers[1] << std::endl;
+}
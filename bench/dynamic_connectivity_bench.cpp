@@ -0,0 +1,99 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include "bench_util.h"
+#include "dynamic_connectivity.h"
+
+// Union-find over all current edges, the baseline that recomputes after every batch.
+struct Components {
+    std::vector<int> parent;
+
+    int find(int v) {
+        while (this->parent[v] != v) {
+            this->parent[v] = this->parent[this->parent[v]];
+            v = this->parent[v];
+        }
+        return v;
+    }
+    void build(int n, const std::vector<std::pair<int,int>>& edges) {
+        this->parent.resize(n);
+        for (int i = 0; i < n; i++) {
+            this->parent[i] = i;
+        }
+        for (auto& edge : edges) {
+            this->parent[this->find(edge.first)] = this->find(edge.second);
+        }
+    }
+};
+
+// Usage: dynamic_connectivity_bench [vertices] [edges] [updates per batch] [queries per batch]
+// Each batch removes and inserts 'updates' random edges, then asks 'queries' connected queries.
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 20000;
+    int m = argc > 2 ? atoi(argv[2]) : n;
+    int updates = argc > 3 ? atoi(argv[3]) : 10;
+    int queries = argc > 4 ? atoi(argv[4]) : 100;
+    const int batches = 1000;
+
+    std::mt19937 rng(42);
+    auto random_edge = [&]() {
+        int u, v;
+        do {
+            u = rng() % n;
+            v = rng() % n;
+        } while (u == v);
+        return std::pair<int,int>(u, v);
+    };
+    std::vector<std::pair<int,int>> edges;
+    while (edges.size() < m) {
+        edges.push_back(random_edge());
+    }
+    // The same operations for both structures.
+    std::vector<int> removed;
+    std::vector<std::pair<int,int>> inserted, asked;
+    for (int i = 0; i < batches * updates; i++) {
+        removed.push_back(rng() % m);
+        inserted.push_back(random_edge());
+    }
+    for (int i = 0; i < batches * queries; i++) {
+        asked.push_back(random_edge());
+    }
+
+    std::cout << "n=" << n << " m=" << m << " updates=" << updates << " queries=" << queries << std::endl;
+    int answers[2] = { 0, 0 };
+    DynamicConnectivity<16> graph = DynamicConnectivity<16>(n);
+    std::vector<std::shared_ptr<EdgeData>> handles;
+    double build = time_seconds([&]() {
+        for (auto& edge : edges) {
+            handles.push_back(graph.insert(edge.first, edge.second));
+        }
+    });
+    double dynamic = time_seconds([&]() {
+        for (int b = 0; b < batches; b++) {
+            for (int i = b * updates; i < (b + 1) * updates; i++) {
+                graph.remove(handles[removed[i]]);
+                handles[removed[i]] = graph.insert(inserted[i].first, inserted[i].second);
+            }
+            for (int i = b * queries; i < (b + 1) * queries; i++) {
+                answers[0] += graph.connected(asked[i].first, asked[i].second);
+            }
+        }
+    });
+
+    Components components;
+    double recompute = time_seconds([&]() {
+        for (int b = 0; b < batches; b++) {
+            for (int i = b * updates; i < (b + 1) * updates; i++) {
+                edges[removed[i]] = inserted[i];
+            }
+            components.build(n, edges);
+            for (int i = b * queries; i < (b + 1) * queries; i++) {
+                answers[1] += components.find(asked[i].first) == components.find(asked[i].second);
+            }
+        }
+    });
+    std::cout << "build-seconds " << build << std::endl;
+    std::cout << "dynamic-batches/s " << batches / dynamic << " recompute-batches/s " << batches / recompute << std::endl;
+    std::cout << "connected " << answers[0] << " " << answers[1] << std::endl;
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "bench_util.h"
+#include "dynamic_msf.h"
+
+// Kruskal's algorithm over all current edges, the baseline that recomputes after every batch.
+long long kruskal(int n, std::vector<std::tuple<int,int,int>> edges, std::vector<int>& parent) {
+    std::sort(edges.begin(), edges.end(), [](auto& a, auto& b) { return std::get<2>(a) < std::get<2>(b); });
+    parent.resize(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int v) {
+        while (parent[v] != v) {
+            v = parent[v] = parent[parent[v]];
+        }
+        return v;
+    };
+    long long weight = 0;
+    for (auto& [u, v, w] : edges) {
+        if (find(u) != find(v)) {
+            parent[find(u)] = find(v);
+            weight += w;
+        }
+    }
+    return weight;
+}
+
+// Usage: dynamic_msf_bench [vertices] [edges] [updates per batch]
+// Each batch replaces 'updates' random edges by new ones with random weights, then reads
+// the forest weight.
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 20000;
+    int m = argc > 2 ? atoi(argv[2]) : 2 * n;
+    int updates = argc > 3 ? atoi(argv[3]) : 10;
+    const int batches = 1000;
+
+    std::mt19937 rng(42);
+    auto random_edge = [&]() {
+        int u, v;
+        do {
+            u = rng() % n;
+            v = rng() % n;
+        } while (u == v);
+        return std::tuple<int,int,int>(u, v, rng() % 1000000);
+    };
+    std::vector<std::tuple<int,int,int>> edges, inserted;
+    std::vector<int> removed;
+    while (edges.size() < m) {
+        edges.push_back(random_edge());
+    }
+    for (int i = 0; i < batches * updates; i++) {
+        removed.push_back(rng() % m);
+        inserted.push_back(random_edge());
+    }
+
+    std::cout << "n=" << n << " m=" << m << " updates=" << updates << std::endl;
+    long long weights[2] = { 0, 0 };
+    DynamicMSF<16> graph = DynamicMSF<16>(n);
+    std::vector<std::shared_ptr<WeightedEdgeData>> handles;
+    double build = time_seconds([&]() {
+        for (auto& [u, v, w] : edges) {
+            handles.push_back(graph.insert(u, v, w));
+        }
+    });
+    double dynamic = time_seconds([&]() {
+        for (int b = 0; b < batches; b++) {
+            for (int i = b * updates; i < (b + 1) * updates; i++) {
+                graph.remove(handles[removed[i]]);
+                auto [u, v, w] = inserted[i];
+                handles[removed[i]] = graph.insert(u, v, w);
+            }
+            weights[0] += graph.forest_weight();
+        }
+    });
+
+    std::vector<int> parent;
+    double recompute = time_seconds([&]() {
+        for (int b = 0; b < batches; b++) {
+            for (int i = b * updates; i < (b + 1) * updates; i++) {
+                edges[removed[i]] = inserted[i];
+            }
+            weights[1] += kruskal(n, edges, parent);
+        }
+    });
+    std::cout << "build-seconds " << build << std::endl;
+    std::cout << "dynamic-batches/s " << batches / dynamic << " recompute-batches/s " << batches / recompute << std::endl;
+    std::cout << "weights " << weights[0] << " " << weights[1] << std::endl;
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "bench_util.h"
+#include "two_edge_connected.h"
+
+// Measures the find first label parts of a TwoEdgeCluster on a random graph with
+// non-tree edges on random levels: a split and merge of the exposed root, which
+// recomputes its incident masks, and the find_first_label descent from the root.
+// Usage: find_first_label_bench [vertices] [edges] [queries]
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 20000;
+    int m = argc > 2 ? atoi(argv[2]) : 2 * n;
+    int queries = argc > 3 ? atoi(argv[3]) : 200000;
+    const int merges_per_query = 8;
+
+    std::mt19937 rng(42);
+    std::cout << "n=" << n << " m=" << m << " queries=" << queries << std::endl;
+    with_two_edge_connectivity(n, [&](auto& graph) {
+        int levels = (int) floor(log2(n));
+        // A random spanning tree first, so that every pair is connected.
+        for (int i = 1; i < n; i++) {
+            graph.insert(i, rng() % i);
+        }
+        for (int i = n - 1; i < m; i++) {
+            int u = rng() % n;
+            int v = rng() % n;
+            if (u != v) {
+                graph.insert(u, v, rng() % levels);
+            }
+        }
+
+        double merge_time = 0;
+        double descent_time = 0;
+        int found = 0;
+        for (int q = 0; q < queries; q++) {
+            int u = rng() % n;
+            int v = rng() % n;
+            int level = rng() % levels;
+            if (u == v) {
+                continue;
+            }
+            auto root = graph.expose(u, v);
+            if (root) {
+                merge_time += time_seconds([&]() {
+                    for (int k = 0; k < merges_per_query; k++) {
+                        root->split_internal();
+                        root->merge_internal();
+                    }
+                });
+                descent_time += time_seconds([&]() {
+                    found += std::get<1>(root->find_first_label(u, v, level)) != nullptr;
+                });
+            }
+            graph.deexpose(u, v);
+        }
+        std::cout << "split+merge(ns) descent(ns) found" << std::endl;
+        std::cout << merge_time * 1e9 / ((double) queries * merges_per_query) << " " 
+                  << descent_time * 1e9 / queries << " " << found << std::endl;
+    });
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include "bench_util.h"
+#include "find_size_kernels.h"
+
+using find_size_kernels::Isa;
+
+// Times the find size row kernels for every supported isa on a (W + 2) x W matrix, which is
+// the shape of a TwoEdgeCluster part_size matrix with level bound W.
+template<int W>
+void bench_width(std::mt19937& rng) {
+    const int iterations = 2000000;
+    Isa isas[] = { Isa::Scalar, Isa::AVX2, Isa::AVX512 };
+    std::vector<int> source((W + 2) * W);
+    for (int& x : source) x = rng() % 100;
+    std::vector<int> target(W, 0);
+
+    for (Isa isa : isas) {
+        if (!find_size_kernels::supported(isa)) {
+            continue;
+        }
+        double rows = time_seconds([&]() {
+            for (int it = 0; it < iterations; it++) {
+                find_size_kernels::sum_rows<W>(isa, target.data(), source.data(), W + 2);
+            }
+        });
+        double triangle = time_seconds([&]() {
+            for (int it = 0; it < iterations; it++) {
+                find_size_kernels::sum_lower_triangle<W>(isa, target.data(), source.data());
+            }
+        });
+        std::cout << W << " " << find_size_kernels::isa_name(isa) << " "
+                  << rows * 1e9 / iterations << " "
+                  << triangle * 1e9 / iterations << std::endl;
+    }
+}
+
+int main() {
+    std::mt19937 rng(1);
+    std::cout << "width isa sum_rows(ns) sum_lower_triangle(ns)" << std::endl;
+    bench_width<5>(rng);
+    bench_width<8>(rng);
+    bench_width<13>(rng);
+    bench_width<16>(rng);
+    bench_width<20>(rng);
+    bench_width<32>(rng);
+    return 0;
+}
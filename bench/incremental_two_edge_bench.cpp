@@ -0,0 +1,59 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include "bench_util.h"
+#include "incremental_two_edge_connected.h"
+
+// Insert throughput of TwoEdgeConnectivity against IncrementalTwoEdgeConnectivity, and
+// the one-off cost the incremental structure pays on its first remove.
+template<class G>
+void run(const char* name, G& graph, const std::vector<std::pair<int,int>>& edges, const std::vector<std::pair<int,int>>& queries) {
+    std::vector<std::shared_ptr<EdgeData>> handles;
+    double insert = time_seconds([&]() {
+        for (auto& edge : edges) {
+            handles.push_back(graph.insert(edge.first, edge.second));
+        }
+    });
+    int connected = 0;
+    double query = time_seconds([&]() {
+        for (auto& q : queries) {
+            connected += graph.two_edge_connected(q.first, q.second);
+        }
+    });
+    double first_remove = time_seconds([&]() {
+        graph.remove(handles.back());
+    });
+    std::cout << name << " " << edges.size() / insert << " " << queries.size() / query << " " << first_remove << " " << connected << std::endl;
+}
+
+// Usage: incremental_two_edge_bench [vertices] [edges] [queries]
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 20000;
+    int m = argc > 2 ? atoi(argv[2]) : 2 * n;
+    int q = argc > 3 ? atoi(argv[3]) : m;
+
+    std::mt19937 rng(42);
+    std::vector<std::pair<int,int>> edges, queries;
+    while (edges.size() < m) {
+        int u = rng() % n;
+        int v = rng() % n;
+        if (u != v) {
+            edges.push_back({ u, v });
+        }
+    }
+    for (int i = 0; i < q; i++) {
+        queries.push_back({ (int) (rng() % n), (int) (rng() % n) });
+    }
+
+    std::cout << "n=" << n << " m=" << m << " queries=" << q << std::endl;
+    std::cout << "structure inserts/s queries/s first-remove-seconds two-edge-connected" << std::endl;
+    {
+        TwoEdgeConnectivity<16> graph = TwoEdgeConnectivity<16>(n);
+        run("eager", graph, edges, queries);
+    }
+    {
+        IncrementalTwoEdgeConnectivity<16> graph = IncrementalTwoEdgeConnectivity<16>(n);
+        run("incremental", graph, edges, queries);
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include "bench_util.h"
+#include "offline_two_edge_connected.h"
+#include "two_edge_connected.h"
+
+struct Operation {
+    enum { Insert, Remove, Query } type;
+    int u;
+    int v; // For Remove, u is the index of the inserted edge
+};
+
+// A random stream of inserts, removes of random live edges and queries, keeping about
+// m edges alive.
+std::vector<Operation> make_stream(int n, int m, int length, std::mt19937& rng) {
+    std::vector<Operation> stream;
+    std::vector<int> live;
+    int inserted = 0;
+    while (stream.size() < length) {
+        int r = rng() % 3;
+        if (r == 0 || live.size() < m / 2) {
+            int u = rng() % n;
+            int v = rng() % n;
+            if (u == v) {
+                continue;
+            }
+            stream.push_back({ Operation::Insert, u, v });
+            live.push_back(inserted++);
+        } else if (r == 1 && live.size() > m) {
+            int i = rng() % live.size();
+            stream.push_back({ Operation::Remove, live[i], 0 });
+            live[i] = live.back();
+            live.pop_back();
+        } else {
+            stream.push_back({ Operation::Query, (int) (rng() % n), (int) (rng() % n) });
+        }
+    }
+    return stream;
+}
+
+// Usage: offline_two_edge_bench [vertices] [live edges] [operations]
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 5000;
+    int m = argc > 2 ? atoi(argv[2]) : n;
+    int length = argc > 3 ? atoi(argv[3]) : 20 * n;
+
+    std::mt19937 rng(42);
+    std::vector<Operation> stream = make_stream(n, m, length, rng);
+
+    int online_connected = 0;
+    double online = time_seconds([&]() {
+        with_two_edge_connectivity(n, [&](auto& graph) {
+            std::vector<std::shared_ptr<EdgeData>> edges;
+            for (Operation& operation : stream) {
+                if (operation.type == Operation::Insert) {
+                    edges.push_back(graph.insert(operation.u, operation.v));
+                } else if (operation.type == Operation::Remove) {
+                    graph.remove(edges[operation.u]);
+                } else {
+                    online_connected += graph.two_edge_connected(operation.u, operation.v);
+                }
+            }
+        });
+    });
+
+    int offline_connected = 0;
+    double offline = time_seconds([&]() {
+        OfflineTwoEdgeConnectivity solver = OfflineTwoEdgeConnectivity(n);
+        std::vector<int> edges;
+        for (Operation& operation : stream) {
+            if (operation.type == Operation::Insert) {
+                edges.push_back(solver.insert(operation.u, operation.v));
+            } else if (operation.type == Operation::Remove) {
+                solver.remove(edges[operation.u]);
+            } else {
+                solver.two_edge_connected(operation.u, operation.v);
+            }
+        }
+        for (bool answer : solver.solve()) {
+            offline_connected += answer;
+        }
+    });
+
+    std::cout << "n=" << n << " m=" << m << " operations=" << length << std::endl;
+    std::cout << "solver seconds two-edge-connected" << std::endl;
+    std::cout << "online " << online << " " << online_connected << std::endl;
+    std::cout << "offline " << offline << " " << offline_connected << std::endl;
+    return 0;
+}
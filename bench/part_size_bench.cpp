@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <iostream>
+#include <malloc.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "bench_util.h"
+#include "two_edge_connected.h"
+
+static std::size_t heap_in_use() {
+    return mallinfo2().uordblks;
+}
+
+// Inserts a random graph and deletes it again, reporting the heap used per vertex once
+// every edge is inserted.
+template<template<int> class P>
+void run(const char* name, int n, const std::vector<std::pair<int,int>>& edges, const std::vector<int>& order) {
+    std::size_t heap_before = heap_in_use();
+    with_two_edge_connectivity<P>(n, [&](auto& graph) {
+        int m = edges.size();
+        std::vector<std::shared_ptr<EdgeData>> handles(m);
+        double insert = time_seconds([&]() {
+            for (int i = 0; i < m; i++) {
+                handles[i] = graph.insert(edges[i].first, edges[i].second);
+            }
+        });
+        double bytes_per_vertex = (double) (heap_in_use() - heap_before) / n;
+        double remove = time_seconds([&]() {
+            for (int i : order) {
+                if (handles[i]) {
+                    graph.remove(handles[i]);
+                }
+            }
+        });
+        std::cout << name << " " << bytes_per_vertex << " " << m / insert << " " << m / remove << std::endl;
+    });
+}
+
+// Compares the dense and sparse part_size representations of TwoEdgeCluster.
+// Usage: part_size_bench [vertices] [edges]
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 20000;
+    int m = argc > 2 ? atoi(argv[2]) : 2 * n;
+
+    std::mt19937 rng(42);
+    std::vector<std::pair<int,int>> edges;
+    for (int i = 0; i < m; i++) {
+        edges.push_back({ (int) (rng() % n), (int) (rng() % n) });
+    }
+    std::vector<int> order(m);
+    for (int i = 0; i < m; i++) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    std::cout << "n=" << n << " m=" << m << std::endl;
+    std::cout << "representation bytes/vertex inserts/s deletes/s" << std::endl;
+    run<DensePartSize>("dense", n, edges, order);
+    run<SparsePartSize>("sparse", n, edges, order);
+    return 0;
+}
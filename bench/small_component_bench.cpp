@@ -0,0 +1,70 @@
+#include <iostream>
+#include <malloc.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "bench_util.h"
+#include "two_edge_connected.h"
+
+static std::size_t heap_in_use() {
+    return mallinfo2().uordblks;
+}
+
+// A graph of many small components: inserts, queries inside the components, and removes
+// with reinserts. Compares the top tree for everything with small components kept outside.
+void run(const char* name, int n, int limit, const std::vector<std::pair<int,int>>& edges, const std::vector<std::pair<int,int>>& queries) {
+    std::size_t heap_before = heap_in_use();
+    TwoEdgeConnectivity<16>* graph = new TwoEdgeConnectivity<16>(n, limit);
+    std::vector<std::shared_ptr<EdgeData>> handles;
+    double insert = time_seconds([&]() {
+        for (auto& edge : edges) {
+            handles.push_back(graph->insert(edge.first, edge.second));
+        }
+    });
+    std::size_t heap = heap_in_use() - heap_before;
+    int connected = 0;
+    double query = time_seconds([&]() {
+        for (auto& q : queries) {
+            connected += graph->two_edge_connected(q.first, q.second);
+        }
+    });
+    double update = time_seconds([&]() {
+        for (int i = 0; i < handles.size(); i += 2) {
+            graph->remove(handles[i]);
+            handles[i] = graph->insert(edges[i].first, edges[i].second);
+        }
+    });
+    delete graph;
+    std::cout << name << " " << edges.size() / insert << " " << queries.size() / query << " " << handles.size() / 2 / update
+              << " " << (double) heap / n << " " << connected << std::endl;
+}
+
+// Usage: small_component_bench [vertices] [component size]
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    int component_size = argc > 2 ? atoi(argv[2]) : 16;
+
+    // Random graphs with 1.5 edges per vertex inside blocks of component_size vertices.
+    std::mt19937 rng(42);
+    std::vector<std::pair<int,int>> edges, queries;
+    for (int start = 0; start + component_size <= n; start += component_size) {
+        for (int i = 0; i < component_size * 3 / 2; i++) {
+            int u = start + rng() % component_size;
+            int v = start + rng() % component_size;
+            if (u != v) {
+                edges.push_back({ u, v });
+            }
+        }
+    }
+    for (int i = 0; i < edges.size(); i++) {
+        int u = rng() % (n - n % component_size);
+        int block = u - u % component_size;
+        queries.push_back({ u, block + (int) (rng() % component_size) });
+    }
+
+    std::cout << "n=" << n << " component size=" << component_size << " m=" << edges.size() << std::endl;
+    std::cout << "limit inserts/s queries/s remove+insert/s heap-bytes/vertex two-edge-connected" << std::endl;
+    run("0", n, 0, edges, queries);
+    run("64", n, 64, edges, queries);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "bench_util.h"
+#include "find_size_kernels.h"
+#include "two_edge_connected.h"
+
+using find_size_kernels::Isa;
+
+// Inserts a random graph and then deletes every edge in random order, once per isa.
+// Usage: two_edge_delete_bench [vertices] [edges]
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 2000;
+    int m = argc > 2 ? atoi(argv[2]) : 4 * n;
+    Isa isas[] = { Isa::Scalar, Isa::AVX2, Isa::AVX512 };
+
+    std::mt19937 rng(42);
+    std::vector<std::pair<int,int>> edges;
+    for (int i = 0; i < m; i++) {
+        edges.push_back({ (int) (rng() % n), (int) (rng() % n) });
+    }
+    std::vector<int> order(m);
+    for (int i = 0; i < m; i++) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    std::cout << "n=" << n << " m=" << m << std::endl;
+    std::cout << "isa insert(s) delete(s)" << std::endl;
+    for (Isa isa : isas) {
+        if (!find_size_kernels::set_isa(isa)) {
+            continue;
+        }
+        with_two_edge_connectivity(n, [&](auto& graph) {
+            std::vector<std::shared_ptr<EdgeData>> handles(m);
+            double insert = time_seconds([&]() {
+                for (int i = 0; i < m; i++) {
+                    handles[i] = graph.insert(edges[i].first, edges[i].second);
+                }
+            });
+            double remove = time_seconds([&]() {
+                for (int i : order) {
+                    if (handles[i]) {
+                        graph.remove(handles[i]);
+                    }
+                }
+            });
+            std::cout << find_size_kernels::isa_name(isa) << " " << insert << " " << remove << std::endl;
+        });
+    }
+    return 0;
+}
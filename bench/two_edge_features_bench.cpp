@@ -0,0 +1,49 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include "bench_util.h"
+#include "two_edge_connected.h"
+
+// Inserts a random graph and answers two_edge_connected queries, with all aggregates
+// and with cover levels only.
+template<template<int> class P, class F>
+void run(const char* name, int n, const std::vector<std::pair<int,int>>& edges, const std::vector<std::pair<int,int>>& queries) {
+    with_two_edge_connectivity<P, F>(n, [&](auto& graph) {
+        double insert = time_seconds([&]() {
+            for (auto& edge : edges) {
+                graph.insert(edge.first, edge.second);
+            }
+        });
+        int connected = 0;
+        double query = time_seconds([&]() {
+            for (auto& q : queries) {
+                connected += graph.two_edge_connected(q.first, q.second);
+            }
+        });
+        std::cout << name << " " << edges.size() / insert << " " << queries.size() / query << " " << connected << std::endl;
+    });
+}
+
+// Usage: two_edge_features_bench [vertices] [edges] [queries]
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 20000;
+    int m = argc > 2 ? atoi(argv[2]) : 2 * n;
+    int q = argc > 3 ? atoi(argv[3]) : m;
+
+    std::mt19937 rng(42);
+    std::vector<std::pair<int,int>> edges, queries;
+    for (int i = 0; i < m; i++) {
+        edges.push_back({ (int) (rng() % n), (int) (rng() % n) });
+    }
+    for (int i = 0; i < q; i++) {
+        queries.push_back({ (int) (rng() % n), (int) (rng() % n) });
+    }
+
+    std::cout << "n=" << n << " m=" << m << " queries=" << q << std::endl;
+    std::cout << "features inserts/s queries/s two-edge-connected" << std::endl;
+    run<DensePartSize, AllFeatures>("all,dense", n, edges, queries);
+    run<SparsePartSize, AllFeatures>("all,sparse", n, edges, queries);
+    run<DensePartSize, BridgesOnly>("bridges-only,dense", n, edges, queries);
+    run<SparsePartSize, BridgesOnly>("bridges-only,sparse", n, edges, queries);
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "bench_util.h"
+#include "two_edge_connected.h"
+
+// Delete latency of TwoEdgeConnectivity, dominated by the recover loop. Keeps the graph at
+// m edges by inserting a random edge after every delete, so the recovered levels fill up.
+// Usage: two_edge_recover_bench [vertices] [edges] [deletes]
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 5000;
+    int m = argc > 2 ? atoi(argv[2]) : 3 * n;
+    int deletes = argc > 3 ? atoi(argv[3]) : 20000;
+
+    std::mt19937 rng(42);
+    auto random_edge = [&]() {
+        int u, v;
+        do {
+            u = rng() % n;
+            v = rng() % n;
+        } while (u == v);
+        return std::pair<int,int>(u, v);
+    };
+
+    std::cout << "n=" << n << " m=" << m << " deletes=" << deletes << std::endl;
+    with_two_edge_connectivity(n, [&](auto& graph) {
+        std::vector<std::shared_ptr<EdgeData>> handles;
+        for (int i = 0; i < m; i++) {
+            auto [u, v] = random_edge();
+            handles.push_back(graph.insert(u, v));
+        }
+        std::vector<double> latency;
+        for (int d = 0; d < deletes; d++) {
+            int i = rng() % m;
+            latency.push_back(time_seconds([&]() {
+                graph.remove(handles[i]);
+            }));
+            auto [u, v] = random_edge();
+            handles[i] = graph.insert(u, v);
+        }
+        double total = 0;
+        for (double t : latency) {
+            total += t;
+        }
+        std::sort(latency.begin(), latency.end());
+        std::cout << "delete mean(us) " << 1e6 * total / deletes
+                  << " p50(us) " << 1e6 * latency[deletes / 2]
+                  << " p99(us) " << 1e6 * latency[deletes * 99 / 100] << std::endl;
+    });
+    return 0;
+}
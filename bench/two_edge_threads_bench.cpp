@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include <time.h>
+#include "bench_util.h"
+#include "two_edge_connected.h"
+
+// Cpu seconds spent by the calling thread.
+double thread_cpu_seconds() {
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// One shard: inserts a random graph into its own instance and deletes every edge again.
+// Stores the cpu seconds the shard took in cpu.
+void run_shard(int n, int m, int seed, double* cpu) {
+    double start = thread_cpu_seconds();
+    std::mt19937 rng(seed);
+    with_two_edge_connectivity(n, [&](auto& graph) {
+        std::vector<std::shared_ptr<EdgeData>> handles;
+        for (int i = 0; i < m; i++) {
+            handles.push_back(graph.insert(rng() % n, rng() % n));
+        }
+        std::shuffle(handles.begin(), handles.end(), rng);
+        for (auto& edge : handles) {
+            if (edge) {
+                graph.remove(edge);
+            }
+        }
+    });
+    *cpu = thread_cpu_seconds() - start;
+}
+
+// Runs 1..threads independent TwoEdgeConnectivity instances, one per thread, and
+// reports the throughput relative to a single instance. The mean cpu time per shard
+// separates the two reasons for a speedup below the thread count: it stays flat when
+// threads only wait for a core, and grows when instances contend for shared state such
+// as cache lines or the allocator.
+// Usage: two_edge_threads_bench [threads] [vertices] [edges]
+int main(int argc, char** argv) {
+    int max_threads = argc > 1 ? atoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    int n = argc > 2 ? atoi(argv[2]) : 1000;
+    int m = argc > 3 ? atoi(argv[3]) : 4 * n;
+
+    std::cout << "n=" << n << " m=" << m << " hardware threads=" << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "threads time(s) shards/s speedup cpu/shard(s)" << std::endl;
+    double single = 0;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        std::vector<double> cpu(threads);
+        double time = time_seconds([&]() {
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; t++) {
+                workers.emplace_back(run_shard, n, m, t, &cpu[t]);
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        });
+        double throughput = threads / time;
+        if (threads == 1) {
+            single = throughput;
+        }
+        double mean_cpu = 0;
+        for (double shard : cpu) {
+            mean_cpu += shard / threads;
+        }
+        std::cout << threads << " " << time << " " << throughput << " " << throughput / single << " " << mean_cpu << std::endl;
+    }
+    return 0;
+}
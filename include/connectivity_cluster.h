@@ -0,0 +1,64 @@
+#ifndef CONNECTIVITY_CLUSTER
+#define CONNECTIVITY_CLUSTER
+
+#include "edge.h"
+#include "two_edge_cluster.h"
+
+#include <memory>
+#include <vector>
+
+template<int L> class ConnectivityCluster;
+template<int L> class DynamicConnectivity;
+
+// The non-tree edges of a vertex by level, held by one leaf of an incident tree edge.
+template<int L>
+struct ConnectivityVertex {
+    std::vector<std::shared_ptr<EdgeData>> labels[L];
+    LevelMask levels = 0; // Levels with a non-empty labels list
+    ConnectivityCluster<L>* leaf_node = nullptr;
+};
+
+// Cluster of DynamicConnectivity. Every tree edge has a level below L, kept in its
+// TreeEdgeData, and the level i forest is made of the tree edges of level i or more.
+// For each boundary vertex the cluster keeps, per level i, the number of its vertices in
+// the level i tree of that vertex, and two masks over the same trees: bit i of labels is
+// set if a vertex there has a level i label, bit i of edges if a tree edge there has
+// level i. A merge is O(L), where TwoEdgeCluster pays O(L^2) for its cover levels.
+//
+// Slot 0 belongs to the left boundary vertex, or to the middle one if there is none on
+// the left, slot 1 likewise on the right. Point clusters keep the same data in both.
+template<int L>
+class ConnectivityCluster : public Node<ConnectivityCluster<L>,TreeEdgeData,None> {
+    static_assert(L < 64, "levels are stored in 64 bit masks");
+    friend class DynamicConnectivity<L>;
+
+    // Leaves only
+    TreeEdgeData* edge_data = nullptr;
+    ConnectivityVertex<L>* vertex[2] = {nullptr,nullptr};
+
+    // Lowest level on the cluster path, L for point clusters.
+    int path_level = L;
+    // swap_data only toggles swapped, use side to get the slot of a boundary.
+    bool swapped = false;
+    int size[2][L];
+    LevelMask labels[2];
+    LevelMask edges[2];
+
+    int side(int slot) { return slot ^ this->swapped; };
+    void reach(int, ConnectivityCluster*, int, int, ConnectivityCluster*, int);
+    void copy_slot(int, int);
+    ConnectivityCluster* descend(LevelMask (ConnectivityCluster::*)[2], int, int*);
+
+    void assign_vertex(int, ConnectivityVertex<L>*);
+    ConnectivityCluster* find_edge(int);
+    ConnectivityVertex<L>* find_label(int);
+
+    public:
+    void create(TreeEdgeData*, None*, None*);
+    void merge(ConnectivityCluster*, ConnectivityCluster*);
+    void swap_data();
+};
+
+#include "connectivity_cluster.hpp"
+
+#endif
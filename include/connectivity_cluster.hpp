@@ -0,0 +1,178 @@
+#include "connectivity_cluster.h"
+
+#include <algorithm>
+#include <cassert>
+
+// Slot of this from the owner's boundary at owner_slot, joined to the other child's
+// boundary at other_slot through a path of the given lowest level. The other child's part
+// is in the level i tree for every i up to that level, the shared vertex is counted once.
+template<int L>
+void ConnectivityCluster<L>::reach(int slot, ConnectivityCluster* owner, int owner_slot, int level, ConnectivityCluster* other, int other_slot) {
+    int* owner_size = owner->size[owner->side(owner_slot)];
+    int* other_size = other->size[other->side(other_slot)];
+    int end = std::min(level + 1, L);
+    for (int i = 0; i < end; i++) {
+        this->size[slot][i] = owner_size[i] + other_size[i] - 1;
+    }
+    for (int i = end; i < L; i++) {
+        this->size[slot][i] = owner_size[i];
+    }
+    LevelMask joined = below_mask(end);
+    this->labels[slot] = owner->labels[owner->side(owner_slot)] | (other->labels[other->side(other_slot)] & joined);
+    this->edges[slot] = owner->edges[owner->side(owner_slot)] | (other->edges[other->side(other_slot)] & joined);
+}
+
+template<int L>
+void ConnectivityCluster<L>::copy_slot(int source, int target) {
+    std::copy(this->size[source], this->size[source] + L, this->size[target]);
+    this->labels[target] = this->labels[source];
+    this->edges[target] = this->edges[source];
+}
+
+template<int L>
+void ConnectivityCluster<L>::create(TreeEdgeData* edge_data, None* left, None* right) {
+    this->swapped = false;
+    this->edge_data = edge_data;
+    int level = edge_data->level;
+    LevelMask vertex_levels[2] = {
+        this->vertex[0] ? this->vertex[0]->levels : 0,
+        this->vertex[1] ? this->vertex[1]->levels : 0
+    };
+    for (int s = 0; s < 2; s++) {
+        for (int i = 0; i < L; i++) {
+            this->size[s][i] = 1 + (i <= level);
+        }
+        this->labels[s] = vertex_levels[s] | (vertex_levels[!s] & below_mask(level + 1));
+        this->edges[s] = level_bit(level);
+    }
+    if (this->is_path()) {
+        this->path_level = level;
+        return;
+    }
+    this->path_level = L;
+    if (this->has_left_boundary()) {
+        this->copy_slot(0, 1);
+    } else {
+        this->copy_slot(1, 0);
+    }
+}
+
+// The left child's slot 1 and the right child's slot 0 are the middle vertex.
+template<int L>
+void ConnectivityCluster<L>::merge(ConnectivityCluster* left, ConnectivityCluster* right) {
+    this->swapped = false;
+    bool left_path = left->is_path();
+    bool right_path = right->is_path();
+    bool point = !this->is_path();
+
+    if (left_path) {
+        this->reach(0, left, 0, left->path_level, right, 0);
+    } else if (!point || !right_path) {
+        this->reach(0, left, 1, L, right, 0);
+    }
+    if (right_path) {
+        this->reach(1, right, 1, right->path_level, left, 1);
+    } else if (!point || !left_path) {
+        this->reach(1, left, 1, L, right, 0);
+    }
+
+    if (!point) {
+        this->path_level = std::min(left->path_level, right->path_level);
+    } else {
+        this->path_level = L;
+        if (left_path) {
+            this->copy_slot(0, 1);
+        } else if (right_path) {
+            this->copy_slot(1, 0);
+        }
+    }
+}
+
+template<int L>
+void ConnectivityCluster<L>::swap_data() {
+    this->swapped = !this->swapped;
+    std::swap(this->vertex[0], this->vertex[1]);
+}
+
+template<int L>
+void ConnectivityCluster<L>::assign_vertex(int vertex, ConnectivityVertex<L>* label) {
+    this->push_flip();
+    int is_right_endpoint = this->get_endpoint_id(1) == vertex;
+    this->vertex[is_right_endpoint] = label;
+}
+
+// Follows bit 'level' of the masks from the boundary at slot *slot of this root down to a
+// leaf, and sets *slot to the slot of the leaf it was reached from. Pushes flips on the way,
+// so the leaf's vertex and endpoints agree with the slot.
+template<int L>
+ConnectivityCluster<L>* ConnectivityCluster<L>::descend(LevelMask (ConnectivityCluster::*masks)[2], int level, int* slot) {
+    ConnectivityCluster* node = this;
+    node->push_flip();
+    if (!get_bit((node->*masks)[node->side(*slot)], level)) {
+        return nullptr;
+    }
+    while (ConnectivityCluster* left = node->get_child(0)) {
+        ConnectivityCluster* right = node->get_child(1);
+        left->push_flip();
+        right->push_flip();
+        bool left_path = left->is_path();
+        bool right_path = right->is_path();
+        // The boundary vertex the search starts from: the far end of a path child, or the
+        // middle vertex.
+        bool from_left = node->is_path() ? (*slot == 0 && left_path) : left_path;
+        bool from_right = node->is_path() ? (*slot == 1 && right_path) : (!left_path && right_path);
+        if (from_left) {
+            if (get_bit((left->*masks)[left->side(0)], level)) {
+                node = left;
+                *slot = 0;
+            } else {
+                node = right;
+                *slot = 0;
+            }
+        } else if (from_right) {
+            if (get_bit((right->*masks)[right->side(1)], level)) {
+                node = right;
+                *slot = 1;
+            } else {
+                node = left;
+                *slot = 1;
+            }
+        } else if (get_bit((left->*masks)[left->side(1)], level)) {
+            node = left;
+            *slot = 1;
+        } else {
+            node = right;
+            *slot = 0;
+        }
+        assert(get_bit((node->*masks)[node->side(*slot)], level));
+    }
+    if (!node->is_path()) {
+        *slot = !node->has_left_boundary();
+    }
+    return node;
+}
+
+// The leaf of a level 'level' tree edge in the level tree of the exposed vertex of this
+// root, or nullptr.
+template<int L>
+ConnectivityCluster<L>* ConnectivityCluster<L>::find_edge(int level) {
+    int slot = 0;
+    return this->descend(&ConnectivityCluster::edges, level, &slot);
+}
+
+// A vertex with a level 'level' label in the level tree of the exposed vertex of this
+// root, or nullptr.
+template<int L>
+ConnectivityVertex<L>* ConnectivityCluster<L>::find_label(int level) {
+    int slot = 0;
+    ConnectivityCluster* leaf = this->descend(&ConnectivityCluster::labels, level, &slot);
+    if (!leaf) {
+        return nullptr;
+    }
+    ConnectivityVertex<L>* vertex = leaf->vertex[slot];
+    if (vertex && get_bit(vertex->levels, level)) {
+        return vertex;
+    }
+    assert(leaf->edge_data->level >= level);
+    return leaf->vertex[!slot];
+}
@@ -0,0 +1,243 @@
+#include "two_edge_cluster.h"
+
+#include <vector>
+
+// Cover and uncover on a cover level with its tags, also used on copies when the tags of
+// ancestors are applied without pushing them down.
+inline void cover_tags_cover(int& cover_level, int& cover_plus, int& cover_minus, int i) {
+    cover_level = std::max(cover_level,i);
+    cover_plus = std::max(cover_plus,i);
+    
+    if (i >= cover_minus) {
+        cover_minus = -1;
+    }
+}
+
+inline void cover_tags_uncover(int& cover_level, int& cover_plus, int& cover_minus, int i) {
+    if (cover_plus > i) {
+        return;
+    }
+    cover_plus = -1;
+    
+    if (cover_level <= i) {
+        cover_level = -1;
+    }
+    if (cover_minus <= i) {
+        cover_minus = i;
+    }
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::cover_level_cover(int i) {
+    cover_tags_cover(this->cover_level, this->cover_plus, this->cover_minus, i);
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::cover_level_uncover(int i) {
+    cover_tags_uncover(this->cover_level, this->cover_plus, this->cover_minus, i);
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::create_cover(TreeEdgeData* edge, None* left, None* right) {
+    // TODO: maybe change EdgeData to int something.
+    if (this->is_path()) {
+        this->cover_level = edge->level;
+        this->global_cover = l_max;
+        
+        this->min_path_edge = edge;
+        this->min_global_edge = nullptr;
+    } else {
+        this->cover_level = l_max;
+        this->global_cover = edge->level;
+        
+        this->min_path_edge = nullptr;
+        this->min_global_edge = edge;    
+    }
+    this->cover_plus = -1;
+    this->cover_minus = -1;
+};
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::merge_cover(TwoEdgeCluster* left, TwoEdgeCluster* right) {
+    if (this->is_path() || this->has_middle_boundary()) {
+        if (left->cover_level <= right->cover_level) {
+            this->cover_level = left->cover_level;
+            this->min_path_edge = left->min_path_edge;
+        } else {
+            this->cover_level = right->cover_level;
+            this->min_path_edge = right->min_path_edge;
+        }
+
+
+        if (left->global_cover <= right->global_cover) {
+            this->global_cover = left->global_cover;
+            this->min_global_edge = left->min_global_edge;
+        } else {
+            this->global_cover = right->global_cover;
+            this->min_global_edge = right->min_global_edge;
+        }
+
+    } else {
+        this->cover_level = l_max;
+        this->min_path_edge = nullptr;
+
+        int global_cover_left;
+        TreeEdgeData* min_global_edge_left;
+        int global_cover_right;
+        TreeEdgeData* min_global_edge_right;
+
+        if (left->global_cover <= left->cover_level) {
+            global_cover_left = left->global_cover;
+            min_global_edge_left = left->min_global_edge;
+        } else {
+            global_cover_left = left->cover_level;
+            min_global_edge_left = left->min_path_edge;
+        }
+
+        if (right->global_cover <= right->cover_level) {
+            global_cover_right = right->global_cover;
+            min_global_edge_right = right->min_global_edge;
+        } else {
+            global_cover_right = right->cover_level;
+            min_global_edge_right = right->min_path_edge;
+        }
+        
+        if (global_cover_left <= global_cover_right) {
+            this->global_cover = global_cover_left;
+            this->min_global_edge = min_global_edge_left;
+        } else {
+            this->global_cover = global_cover_right;
+            this->min_global_edge = min_global_edge_right;
+        }
+
+    }
+    this->cover_plus = -1;
+    this->cover_minus = -1;
+
+};
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::destroy_cover(TreeEdgeData* edge_data, None* left, None* right) {
+    if (this->is_path()) {
+        edge_data->level = this->cover_level;
+    }
+    this->cover_level = -1;
+    this->cover_minus = -1;
+    this->cover_plus = -1;
+    this->global_cover = -1;
+    this->min_global_edge = nullptr;
+    this->min_path_edge = nullptr;
+}
+
+template<int L, class P, class F>
+int TwoEdgeCluster<L,P,F>::get_cover_level() {
+    assert(!this->dirty);
+    return this->cover_level;
+};
+
+// Cover levels only rise to i, so every path edge below i moves to level i.
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::bridge_count_cover(int i) {
+    int moved = 0;
+    for (int level = -1; level < i; level++) {
+        moved += this->path_edges[level + 1];
+        this->path_edges[level + 1] = 0;
+    }
+    this->path_edges[i + 1] += moved;
+}
+
+// Path edges at level i or below become bridges.
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::bridge_count_uncover(int i) {
+    for (int level = 0; level <= i; level++) {
+        this->path_edges[0] += this->path_edges[level + 1];
+        this->path_edges[level + 1] = 0;
+    }
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::create_bridge_count(TreeEdgeData* edge) {
+    std::fill_n(this->path_edges, L + 2, 0);
+    if (this->is_path()) {
+        this->path_edges[edge->level + 1] = 1;
+        this->global_bridges = 0;
+    } else {
+        this->global_bridges = edge->level == -1;
+    }
+}
+
+// Same case split as merge_cover: outside a path cluster, or one with a middle boundary,
+// the path edges of the children are no longer on a path.
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::merge_bridge_count(TwoEdgeCluster* left, TwoEdgeCluster* right) {
+    this->global_bridges = left->global_bridges + right->global_bridges;
+    if (this->is_path() || this->has_middle_boundary()) {
+        for (int i = 0; i < L + 2; i++) {
+            this->path_edges[i] = left->path_edges[i] + right->path_edges[i];
+        }
+    } else {
+        this->global_bridges += left->path_edges[0] + right->path_edges[0];
+        std::fill_n(this->path_edges, L + 2, 0);
+    }
+}
+
+template<int L, class P, class F>
+int TwoEdgeCluster<L,P,F>::get_path_bridges() {
+    static_assert(F::count_bridges, "bridge counts are disabled in F");
+    assert(!this->dirty);
+    return this->path_edges[0];
+}
+
+template<int L, class P, class F>
+int TwoEdgeCluster<L,P,F>::get_bridges() {
+    static_assert(F::count_bridges, "bridge counts are disabled in F");
+    assert(!this->dirty);
+    return this->path_edges[0] + this->global_bridges;
+}
+
+// Appends the bridges below this cluster, at most 'limit' of them: the path edges with
+// cover level -1, and with 'path_only' unset also the other edges with cover level -1.
+// Descends only into clusters with a bridge, applying the pending tags of the ancestors
+// to copies, so nothing is split and a root with k bridges costs O((k + 1) depth).
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::find_bridges(bool path_only, int limit, std::vector<TreeEdgeData*>& bridges) {
+    assert(!this->dirty);
+    struct Frame {
+        TwoEdgeCluster* node;
+        int cover_level;
+        int cover_plus;
+        int cover_minus;
+    };
+    std::vector<Frame> stack;
+    stack.push_back(Frame { this, this->cover_level, this->cover_plus, this->cover_minus });
+    while (!stack.empty() && bridges.size() < limit) {
+        Frame frame = stack.back();
+        stack.pop_back();
+        TwoEdgeCluster* node = frame.node;
+        bool path_bridge = frame.cover_level == -1;
+        if (!path_bridge && (path_only || node->global_cover != -1)) {
+            continue;
+        }
+        if (!node->get_child(0)) {
+            bridges.push_back(path_bridge ? node->min_path_edge : node->min_global_edge);
+            continue;
+        }
+        for (int i = 0; i < 2; i++) {
+            TwoEdgeCluster* child = node->get_child(i);
+            if (path_only && !child->is_path()) {
+                continue;
+            }
+            Frame child_frame = Frame { child, child->cover_level, child->cover_plus, child->cover_minus };
+            // As in split, tags go from path clusters to their path children.
+            if (node->is_path() && child->is_path()) {
+                if (frame.cover_minus != -1) {
+                    cover_tags_uncover(child_frame.cover_level, child_frame.cover_plus, child_frame.cover_minus, frame.cover_minus);
+                }
+                if (frame.cover_plus != -1) {
+                    cover_tags_cover(child_frame.cover_level, child_frame.cover_plus, child_frame.cover_minus, frame.cover_plus);
+                }
+            }
+            stack.push_back(child_frame);
+        }
+    }
+}
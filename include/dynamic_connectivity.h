@@ -0,0 +1,62 @@
+#ifndef DYNAMIC_CONNECTIVITY
+#define DYNAMIC_CONNECTIVITY
+
+#include "edge.h"
+#include "connectivity_cluster.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// Connectivity of a general graph under edge insertions and deletions, after Holm,
+// de Lichtenberg and Thorup. A spanning forest is kept in a top tree of
+// ConnectivityClusters. Every edge has a level, tree edges in their TreeEdgeData and
+// non-tree edges as labels at both endpoints, and the endpoints of a level i non-tree
+// edge are joined by tree edges of level i or more. The level i trees have at most
+// n / 2^i vertices, so L must be at least floor(log2(size)).
+//
+// Removing a non-tree edge only drops its labels. Removing a tree edge searches levels
+// from its own down for a replacement. On each level the smaller side is scanned for
+// labels, skipping levels where it has none. Each found non-tree edge is either a
+// replacement, which becomes a tree edge of that level, or is raised a level, after the
+// tree edges of that level on the side are. Every edge rises at most log n times, so
+// updates take polylogarithmic amortized time. connected compares the roots above both
+// vertices and splays deep leaves, see TopTree::connected, which is amortized O(log n).
+//
+// The clusters are O(L), where TwoEdgeCluster pays O(L^2), which makes an expose about
+// six times cheaper. On random graphs with m = n and 100 queries per batch, this beats
+// rebuilding union-find after every batch while batches have up to about n / 2000
+// updates: about 1.25 times at n = 20000 and 10 updates, 7 times at n = 200000 and 10
+// updates. At n = 20000 and 100 updates the rebuild is 7 times faster. Denser graphs
+// move the crossover up, at m = 2n and n = 20000 batches of 10 are 2.5 times faster.
+// See bench/dynamic_connectivity_bench.
+template<int L = 32>
+class DynamicConnectivity {
+    TopTree<ConnectivityCluster<L>,TreeEdgeData,None> top_tree;
+    using ExposeSession = typename TopTree<ConnectivityCluster<L>,TreeEdgeData,None>::ExposeSession;
+    std::vector<ConnectivityVertex<L>> vertices;
+
+    ConnectivityCluster<L>* link(std::shared_ptr<EdgeData>, int);
+    void reassign_vertices(ConnectivityCluster<L>*);
+    void recompute(int);
+    void add_label(int, std::shared_ptr<EdgeData>);
+    void remove_labels(std::shared_ptr<EdgeData>);
+    void raise_label(std::shared_ptr<EdgeData>);
+    void raise_tree_edges(int, int);
+    void reach(int, int*, LevelMask*);
+    std::shared_ptr<EdgeData> find_replacement(int, int);
+
+    public:
+    // Returns nullptr for a self-loop.
+    std::shared_ptr<EdgeData> insert(int, int);
+    void remove(std::shared_ptr<EdgeData>);
+    bool connected(int, int);
+
+    DynamicConnectivity(int size) : top_tree(size), vertices(size) {
+        assert(size <= 1 || (int) floor(log2(size)) <= L);
+    };
+};
+
+#include "dynamic_connectivity.hpp"
+
+#endif
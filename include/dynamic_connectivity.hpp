@@ -0,0 +1,229 @@
+#include "dynamic_connectivity.h"
+
+template<int L>
+std::shared_ptr<EdgeData> DynamicConnectivity<L>::insert(int u, int v) {
+    if (u == v) {
+        return nullptr;
+    }
+    std::shared_ptr<EdgeData> edge = std::make_shared<EdgeData>(u, v);
+    // connected walks up from the leaves, cheaper than the two exposes of a failed link.
+    if (!this->top_tree.connected(u, v)) {
+        this->link(edge, 0);
+        return edge;
+    }
+    // Level 0 non tree edge
+    edge->edge_type = NonTreeEdge;
+    edge->level = 0;
+    this->add_label(u, edge);
+    this->add_label(v, edge);
+    return edge;
+}
+
+// Links edge into the spanning forest at the given level, if its endpoints are not
+// connected, and gives its endpoints the new leaf if they had none. Returns the leaf or nullptr.
+template<int L>
+ConnectivityCluster<L>* DynamicConnectivity<L>::link(std::shared_ptr<EdgeData> edge, int level) {
+    int u = edge->endpoints[0];
+    int v = edge->endpoints[1];
+    ConnectivityCluster<L>* result = this->top_tree.link_leaf(u, v, TreeEdgeData(u, v, level));
+    if (!result) {
+        return nullptr;
+    }
+    edge->edge_type = TreeEdge;
+    edge->level = -1;
+    edge->extra_data.leaf_node = result;
+    result->full_splay();
+    if (!this->vertices[u].leaf_node) {
+        result->assign_vertex(u, &this->vertices[u]);
+        this->vertices[u].leaf_node = result;
+    }
+    if (!this->vertices[v].leaf_node) {
+        result->assign_vertex(v, &this->vertices[v]);
+        this->vertices[v].leaf_node = result;
+    }
+    result->recompute_root_path();
+    return result;
+}
+
+// Moves the vertices held by a leaf that is about to be cut to other leaves of their edges.
+template<int L>
+void DynamicConnectivity<L>::reassign_vertices(ConnectivityCluster<L>* leaf_node) {
+    leaf_node->full_splay();
+    // A pending flip has swapped vertex but not the endpoints yet.
+    leaf_node->push_flip();
+    ConnectivityVertex<L>* old_vertices[2] = {leaf_node->vertex[0],leaf_node->vertex[1]};
+    leaf_node->vertex[0] = nullptr;
+    leaf_node->vertex[1] = nullptr;
+    leaf_node->recompute_root_path();
+    for (int i = 0; i < 2; i++) {
+        if (!old_vertices[i]) {
+            continue;
+        }
+        int id = leaf_node->get_endpoint_id(i);
+        ConnectivityCluster<L>* replacement = this->top_tree.get_adjacent_leaf_node(id);
+        if (replacement == leaf_node) {
+            replacement = this->top_tree.get_adjacent_leaf_node(id, 1);
+            if (!replacement) {
+                old_vertices[i]->leaf_node = nullptr;
+                continue;
+            }
+        }
+        replacement->full_splay();
+        replacement->assign_vertex(id, old_vertices[i]);
+        old_vertices[i]->leaf_node = replacement;
+        replacement->recompute_root_path();
+    }
+}
+
+// Recomputes the clusters above the leaf holding a vertex after its labels changed.
+template<int L>
+void DynamicConnectivity<L>::recompute(int vertex) {
+    ConnectivityCluster<L>* leaf_node = this->vertices[vertex].leaf_node;
+    if (leaf_node) {
+        leaf_node->full_splay(); //depth <= 5
+        leaf_node->recompute_root_path();
+    }
+}
+
+template<int L>
+void DynamicConnectivity<L>::add_label(int vertex, std::shared_ptr<EdgeData> edge) {
+    ConnectivityVertex<L>& vertex_label = this->vertices[vertex];
+    edge->extra_data.index[edge->endpoints[1] == vertex] = vertex_label.labels[edge->level].size();
+    vertex_label.labels[edge->level].push_back(edge);
+    vertex_label.levels |= level_bit(edge->level);
+    this->recompute(vertex);
+}
+
+template<int L>
+void DynamicConnectivity<L>::remove_labels(std::shared_ptr<EdgeData> edge) {
+    int level = edge->level;
+    for (int i = 0; i < 2; i++) {
+        int ep = edge->endpoints[i];
+        int ep_idx = edge->extra_data.index[i];
+        ConnectivityVertex<L>& ep_label = this->vertices[ep];
+
+        std::shared_ptr<EdgeData> last_label = ep_label.labels[level].back();
+        ep_label.labels[level][ep_idx] = last_label;
+        last_label->extra_data.index[last_label->endpoints[1] == ep] = ep_idx;
+        ep_label.labels[level].pop_back();
+        if (ep_label.labels[level].empty()) {
+            clear_bit(&ep_label.levels, level);
+        }
+        this->recompute(ep);
+    }
+}
+
+template<int L>
+void DynamicConnectivity<L>::raise_label(std::shared_ptr<EdgeData> edge) {
+    assert(edge->level + 1 < L);
+    this->remove_labels(edge);
+    edge->level += 1;
+    this->add_label(edge->endpoints[0], edge);
+    this->add_label(edge->endpoints[1], edge);
+}
+
+// Raises every level 'level' tree edge in the level tree of w one level.
+template<int L>
+void DynamicConnectivity<L>::raise_tree_edges(int w, int level) {
+    assert(level + 1 < L);
+    while (true) {
+        ConnectivityCluster<L>* leaf_node = nullptr;
+        {
+            ExposeSession session(this->top_tree, w);
+            if (session.get_root()) {
+                leaf_node = session.get_root()->find_edge(level);
+            }
+        }
+        if (!leaf_node) {
+            return;
+        }
+        leaf_node->full_splay();
+        leaf_node->edge_data->level = level + 1;
+        leaf_node->recompute_root_path();
+    }
+}
+
+// Per level the size of the level tree of a vertex, and the levels with labels in it.
+template<int L>
+void DynamicConnectivity<L>::reach(int vertex, int* size, LevelMask* labels) {
+    ExposeSession session(this->top_tree, vertex);
+    ConnectivityCluster<L>* root = session.get_root();
+    if (!root) {
+        std::fill(size, size + L, 1);
+        *labels = this->vertices[vertex].levels;
+        return;
+    }
+    root->push_flip();
+    std::copy(root->size[root->side(0)], root->size[root->side(0)] + L, size);
+    *labels = root->labels[root->side(0)];
+}
+
+template<int L>
+void DynamicConnectivity<L>::remove(std::shared_ptr<EdgeData> edge) {
+    if (edge->edge_type == NonTreeEdge) {
+        this->remove_labels(edge);
+        return;
+    }
+    int u = edge->endpoints[0];
+    int v = edge->endpoints[1];
+    ConnectivityCluster<L>* leaf_node = (ConnectivityCluster<L>*) edge->extra_data.leaf_node;
+    int level = leaf_node->edge_data->level;
+    this->reassign_vertices(leaf_node);
+    this->top_tree.cut_leaf(leaf_node);
+
+    // Searching a level only raises edges from it to the next, so the sizes and labels
+    // on the levels below stay as read here.
+    int size[2][L];
+    LevelMask labels[2];
+    this->reach(u, size[0], &labels[0]);
+    this->reach(v, size[1], &labels[1]);
+    for (int i = level; i >= 0; i--) {
+        int side = size[1][i] < size[0][i];
+        if (!get_bit(labels[side], i)) {
+            continue;
+        }
+        std::shared_ptr<EdgeData> replacement = this->find_replacement(edge->endpoints[side], i);
+        if (replacement) {
+            this->remove_labels(replacement);
+            this->link(replacement, i);
+            return;
+        }
+    }
+}
+
+// Scans the labels of the level tree of w, the smaller side, for an edge to the other
+// side. The others are raised to level + 1, the tree they form there is at most half the
+// size of the level tree before the cut.
+template<int L>
+std::shared_ptr<EdgeData> DynamicConnectivity<L>::find_replacement(int w, int level) {
+    bool tree_raised = false;
+    while (true) {
+        ConnectivityVertex<L>* vertex = nullptr;
+        {
+            ExposeSession session(this->top_tree, w);
+            if (session.get_root()) {
+                vertex = session.get_root()->find_label(level);
+            } else if (get_bit(this->vertices[w].levels, level)) {
+                vertex = &this->vertices[w];
+            }
+        }
+        if (!vertex) {
+            return nullptr;
+        }
+        std::shared_ptr<EdgeData> label = vertex->labels[level].back();
+        if (!this->top_tree.connected(label->endpoints[0], label->endpoints[1])) {
+            return label;
+        }
+        // Its endpoints must be joined on the next level first.
+        if (!tree_raised) {
+            this->raise_tree_edges(w, level);
+            tree_raised = true;
+        }
+        this->raise_label(label);
+    }
+}
+
+template<int L>
+bool DynamicConnectivity<L>::connected(int u, int v) {
+    return u == v || this->top_tree.connected(u, v);
+}
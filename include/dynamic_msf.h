@@ -0,0 +1,64 @@
+#ifndef DYNAMIC_MSF
+#define DYNAMIC_MSF
+
+#include "edge.h"
+#include "two_edge_connected.h"
+#include "path_max_cluster.h"
+
+#include <memory>
+#include <vector>
+
+using MSFFeatures = TwoEdgeFeatures<true, true, false, true>;
+
+struct WeightedEdgeData : WeightedLabel, std::enable_shared_from_this<WeightedEdgeData> {
+    // Its edge in the path max top tree while it is a tree edge.
+    Edge<PathMaxCluster,PathMaxEdge,None>* path_edge = nullptr;
+
+    WeightedEdgeData(int u, int v, int weight) : WeightedLabel(u, v, weight) {};
+};
+
+// Minimum spanning forest of a weighted graph under edge insertions and deletions.
+// The forest is kept twice: in a TwoEdgeConnectivity top tree, whose labels and cover
+// levels serve as the levels of Holm, de Lichtenberg and Thorup, and in a top tree of
+// PathMaxClusters. The cover level of a tree edge is at least the level of every non-tree
+// edge whose tree path contains it.
+//
+// An insert between connected vertices exposes their path and swaps the new edge in if
+// it is lighter than the heaviest edge there. The swapped out edge keeps its cover level
+// on its new tree path, so every non-tree edge still covers its path at its level.
+// Removing a tree edge scans the smaller side from the edge's cover level down, as
+// DynamicConnectivity does from its level, but in weight order: the labels of each vertex
+// are heaps by weight, and the clusters keep the lightest label per level besides the
+// label bits.
+// Non-tree edges inside the side are raised a level until the lightest one across the
+// cut on the level turns up, it is left in place. The lightest of those over all levels
+// replaces the edge. Holm, de Lichtenberg and Thorup stop at the first level with a
+// replacement, which needs their invariant that heavier non-tree edges sit on lower
+// levels. Raising edges by size does not keep it, so every level is scanned, and a
+// remove pays for O(L) non-tree edges across the cut on top of the raised ones.
+template<int L = 32, class P = DensePartSize<L>>
+class DynamicMSF {
+    TwoEdgeConnectivity<L,P,MSFFeatures> graph;
+    TopTree<PathMaxCluster,PathMaxEdge,None> path_max;
+    long long weight = 0;
+    std::vector<std::shared_ptr<EdgeData>> set_aside;
+
+    void link(std::shared_ptr<WeightedEdgeData>);
+    void cut(std::shared_ptr<EdgeData>);
+    void add_non_tree_edge(std::shared_ptr<EdgeData>, int);
+    std::shared_ptr<EdgeData> scan_level(int, int, int);
+
+    public:
+    // Returns nullptr for a self-loop.
+    std::shared_ptr<WeightedEdgeData> insert(int, int, int);
+    void remove(std::shared_ptr<WeightedEdgeData>);
+    bool connected(int, int);
+    // Total weight of the forest.
+    long long forest_weight() { return this->weight; };
+
+    DynamicMSF(int size) : graph(size), path_max(size) {};
+};
+
+#include "dynamic_msf.hpp"
+
+#endif
@@ -0,0 +1,151 @@
+#include "dynamic_msf.h"
+
+template<int L, class P>
+void DynamicMSF<L,P>::link(std::shared_ptr<WeightedEdgeData> edge) {
+    int u = edge->endpoints[0];
+    int v = edge->endpoints[1];
+    this->graph.link_tree_edge(edge);
+    edge->path_edge = this->path_max.link_ptr(u, v, PathMaxEdge { edge->weight, edge });
+    this->weight += edge->weight;
+}
+
+template<int L, class P>
+void DynamicMSF<L,P>::cut(std::shared_ptr<EdgeData> edge) {
+    WeightedEdgeData* weighted = static_cast<WeightedEdgeData*>(edge.get());
+    TwoEdgeCluster<L,P,MSFFeatures>* leaf_node = (TwoEdgeCluster<L,P,MSFFeatures>*) edge->extra_data.leaf_node;
+    this->graph.reassign_vertices(leaf_node);
+    this->graph.top_tree.cut_leaf(leaf_node);
+    this->path_max.cut_ptr(weighted->path_edge);
+    weighted->path_edge = nullptr;
+    this->weight -= weighted->weight;
+}
+
+template<int L, class P>
+void DynamicMSF<L,P>::add_non_tree_edge(std::shared_ptr<EdgeData> edge, int level) {
+    edge->edge_type = NonTreeEdge;
+    edge->level = level;
+    this->graph.add_label(edge->endpoints[0], edge);
+    this->graph.add_label(edge->endpoints[1], edge);
+}
+
+template<int L, class P>
+std::shared_ptr<WeightedEdgeData> DynamicMSF<L,P>::insert(int u, int v, int weight) {
+    if (u == v) {
+        return nullptr;
+    }
+    std::shared_ptr<WeightedEdgeData> edge = std::make_shared<WeightedEdgeData>(u, v, weight);
+    std::shared_ptr<WeightedEdgeData> heaviest = nullptr;
+    {
+        TopTree<PathMaxCluster,PathMaxEdge,None>::ExposeSession session(this->path_max, u, v);
+        if (session.connected()) {
+            heaviest = session.get_root()->max_edge->shared_from_this();
+        }
+    }
+    if (!heaviest) {
+        this->link(edge);
+        return edge;
+    }
+    if (weight >= heaviest->weight) {
+        this->add_non_tree_edge(edge, 0);
+        this->graph.cover(u, v, 0);
+        return edge;
+    }
+
+    // Swap the heaviest edge out. The non-tree edges whose paths went through it now go
+    // around the rest of its cycle, which gets its cover level.
+    int x = heaviest->endpoints[0];
+    int y = heaviest->endpoints[1];
+    int level = std::max(this->graph.cover_level(x, y), 0);
+    this->cut(heaviest);
+    this->link(edge);
+    this->add_non_tree_edge(heaviest, 0);
+    this->graph.cover(x, y, level);
+    return edge;
+}
+
+template<int L, class P>
+void DynamicMSF<L,P>::remove(std::shared_ptr<WeightedEdgeData> edge) {
+    if (edge->edge_type == NonTreeEdge) {
+        this->graph.remove_labels(edge);
+        return;
+    }
+    int u = edge->endpoints[0];
+    int v = edge->endpoints[1];
+    int level = this->graph.cover_level(u, v);
+    this->cut(edge);
+
+    // The lightest edge across the cut on each level, and the highest level with one.
+    std::shared_ptr<EdgeData> lightest = nullptr;
+    int top = -1;
+    for (int i = level; i >= 0; i--) {
+        std::shared_ptr<EdgeData> candidate = this->scan_level(u, v, i);
+        if (!candidate) {
+            continue;
+        }
+        if (top == -1) {
+            top = i;
+        }
+        if (!lightest || static_cast<WeightedEdgeData*>(candidate.get())->weight < static_cast<WeightedEdgeData*>(lightest.get())->weight) {
+            lightest = candidate;
+        }
+    }
+    if (!lightest) {
+        return;
+    }
+    this->graph.remove_labels(lightest);
+    this->link(std::static_pointer_cast<WeightedEdgeData>(lightest));
+    // The edges across the cut left in place now go through the replacement. Their paths
+    // to u and v are still covered at their levels, so covering the path between u and v
+    // at the highest of them covers their new paths.
+    this->graph.cover(u, v, top);
+}
+
+// Scans the labels of the smaller level i tree of u and v, with u and v cut apart, in
+// weight order. Labels inside the tree are raised to level i + 1 as in
+// DynamicConnectivity, or set aside while scanning on the last level. Every label found is
+// at most as heavy as those left that are reachable from w, and every label across the
+// cut on the level is reachable, its old path was covered at the level. So the first one
+// across is the lightest, it is returned and stays in place.
+template<int L, class P>
+std::shared_ptr<EdgeData> DynamicMSF<L,P>::scan_level(int u, int v, int level) {
+    int size_u = this->graph.find_size(u, u, level);
+    int size_v = this->graph.find_size(v, v, level);
+    int w = size_u <= size_v ? u : v;
+
+    this->set_aside.clear();
+    std::shared_ptr<EdgeData> label = this->graph.find_lightest_label(w, level);
+    while (label) {
+        int q = label->endpoints[0];
+        int r = label->endpoints[1];
+        bool raised = false;
+        {
+            typename TwoEdgeConnectivity<L,P,MSFFeatures>::ExposeSession session(this->graph.top_tree, q, r);
+            if (!session.connected()) {
+                break;
+            }
+            if (level + 1 < L) {
+                session.get_root()->cover(level + 1);
+                raised = true;
+            }
+        }
+        this->graph.remove_labels(label);
+        if (raised) {
+            label->level = level + 1;
+            this->graph.add_label(q, label);
+            this->graph.add_label(r, label);
+        } else {
+            this->set_aside.push_back(label);
+        }
+        label = this->graph.find_lightest_label(w, level);
+    }
+    for (std::shared_ptr<EdgeData>& edge : this->set_aside) {
+        this->graph.add_label(edge->endpoints[0], edge);
+        this->graph.add_label(edge->endpoints[1], edge);
+    }
+    return label;
+}
+
+template<int L, class P>
+bool DynamicMSF<L,P>::connected(int u, int v) {
+    return u == v || this->graph.top_tree.connected(u, v);
+}
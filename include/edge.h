@@ -5,11 +5,10 @@
 #include <cassert>
 #include <memory>
 
-struct TwoEdgeCluster;
-
-enum EdgeType { TreeEdge, NonTreeEdge };
+// SmallComponentEdge: the edge lives in a SmallComponent, not in the top tree.
+enum EdgeType { TreeEdge, NonTreeEdge, SmallComponentEdge };
 union ExtraData {
-    TwoEdgeCluster* leaf_node;
+    void* leaf_node; // TwoEdgeCluster<L,P>* of a tree edge, EdgeData is shared by all of them
     int index[2];
 };
 
@@ -35,7 +34,7 @@ struct EdgeData {
     int level; //If TreeEdge cover_level, if NonTreeEdge level
     ExtraData extra_data;
     
-    EdgeData(int u, int v, int cl, TwoEdgeCluster* leaf_node) { // Specific tree edge constructor
+    EdgeData(int u, int v, int cl, void* leaf_node) { // Specific tree edge constructor
         this->edge_type = TreeEdge;
         this->endpoints[0] = u;
         this->endpoints[1] = v;
@@ -60,4 +59,13 @@ struct EdgeData {
     };
 };
 
+// An edge with a weight. With FindLightestLabel the labels are WeightedLabels, ordered by it.
+struct WeightedLabel : EdgeData {
+    int weight;
+
+    WeightedLabel(int u, int v, int weight) : EdgeData(u, v) {
+        this->weight = weight;
+    };
+};
+
 #endif
\ No newline at end of file
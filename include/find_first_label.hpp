@@ -0,0 +1,270 @@
+#include "two_edge_cluster.h"
+#include <cassert>
+#include <tuple>
+#include <vector>
+
+
+inline LevelMask level_bit(int pos) {
+    return LevelMask(1) << pos;
+}
+
+// Bits [0, pos). pos is at most l_max + 1 < 64.
+inline LevelMask below_mask(int pos) {
+    return level_bit(pos) - 1;
+}
+
+inline void set_bit(LevelMask* bitvec, int pos) {
+    *bitvec |= level_bit(pos);
+}
+
+inline void clear_bit(LevelMask* bitvec, int pos) {
+    *bitvec &= ~level_bit(pos);
+}
+
+inline void clear_from(LevelMask* bitvec, int pos) {
+    *bitvec &= below_mask(pos);
+}
+
+inline bool get_bit(LevelMask bitvec, int pos) {
+    return (bitvec >> pos) & 1;
+}
+
+// Ors row i of source, restricted to levels below i - 1, into target_row.
+template<int L>
+void or_diagonal(LevelMask* target_row, const LevelMask* source) { 
+    // Start from 1, i.e. row 0, as row -1 is 0s. 
+    LevelMask result = 0;
+    for (int i = 1; i < L + 2; i++) {
+        result |= source[i] & below_mask(i);
+    }
+    *target_row |= result;
+}
+
+inline void or_row_range(LevelMask* target_row, const LevelMask* source, int start, int end) { 
+    LevelMask result = 0;
+    for (int i = start; i < end; i++) {
+        result |= source[i];
+    }
+    *target_row |= result;
+}
+
+template<int L>
+void compute_part_incident(LevelMask* target_part_incident, const LevelMask* owner_part_incident, const LevelMask* other_part_incident, int cover_level) {
+    int cover_level_idx = cover_level + 1; 
+
+    // Rows below the cover level come from the other child, rows above from the owner.
+    std::copy_n(other_part_incident, cover_level_idx, target_part_incident);
+    std::copy(owner_part_incident + cover_level_idx, owner_part_incident + L + 2, target_part_incident + cover_level_idx);
+    or_row_range(&target_part_incident[cover_level_idx], other_part_incident, cover_level_idx, L + 2);
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::create_find_first_label(TreeEdgeData* edge, None*, None*) {
+    int cover_level_idx = edge->level + 1;
+    int lmax_idx = this->l_max + 1;
+    
+    LevelMask label[2] = {0,0};
+    
+    if (this->has_left_boundary())  {
+        this->boundary_vertices_id[0] = this->get_endpoint_id(0);
+    }
+    if (this->has_right_boundary()) {
+        this->boundary_vertices_id[1] = this->get_endpoint_id(1);
+    }
+
+    // Calculate labels
+    for (int i = 0; i < 2; i++) {     
+        if (this->vertex[i]) {
+            label[i] = this->vertex[i]->levels;
+        }
+    }
+
+    if (this->get_num_boundary_vertices() == 1) {
+        if (this->has_left_boundary()) {
+            clear_from(&label[1], this->cover_level + 1);
+        } else {
+            clear_from(&label[0], this->cover_level + 1);
+        }
+        this->incident = label[0] | label[1];
+        this->get_part_incident(!this->has_left_boundary())[lmax_idx] = this->incident;
+    } else if (this->get_num_boundary_vertices() == 2) {
+        this->incident = label[0] | label[1];
+        this->get_part_incident(0)[lmax_idx] = label[0];
+        this->get_part_incident(0)[cover_level_idx] = label[1];
+        this->get_part_incident(1)[lmax_idx] = label[1];
+        this->get_part_incident(1)[cover_level_idx] = label[0];
+    } 
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::destroy_find_first_label(TreeEdgeData* edge, None*, None*) {
+    this->boundary_vertices_id[0] = -1;
+    this->boundary_vertices_id[1] = -1;
+    this->incident = 0;
+    std::fill_n(this->part_incident[0], this->l_max + 2, 0);
+    std::fill_n(this->part_incident[1], this->l_max + 2, 0);
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::merge_find_first_label(TwoEdgeCluster* left, TwoEdgeCluster* right) {
+    //First update the boundary vertex ids on the cluster
+    this->boundary_vertices_id[0]   = this->has_left_boundary() 
+                                    ? left->boundary_vertices_id[0]
+                                    : this->has_middle_boundary() 
+                                    ? left->boundary_vertices_id[1]
+                                    : -1;
+    this->boundary_vertices_id[1]   = this->has_right_boundary() 
+                                    ? right->boundary_vertices_id[1]
+                                    : this->has_middle_boundary() 
+                                    ? right->boundary_vertices_id[0]
+                                    : -1;
+
+    //Then update the incident vector and part_incident vectors.
+    int lmax_idx = this->l_max + 1;
+    
+    if (this->get_num_boundary_vertices() == 1 && !this->has_middle_boundary()) { // Off the path
+        if (this->has_left_boundary()) { 
+            LevelMask right_cleared = right->incident;
+            clear_from(&right_cleared, left->get_cover_level() + 1);
+            or_diagonal<L>(&right_cleared, left->get_part_incident(0)); 
+            this->incident = right_cleared;
+        } else if (this->has_right_boundary()) {
+            LevelMask left_cleared = left->incident;
+            clear_from(&left_cleared, right->get_cover_level() + 1);
+            or_diagonal<L>(&left_cleared, right->get_part_incident(1));  
+            this->incident = left_cleared;
+        }
+        
+        // Copy size into part_incident row: lmax, the only non-zero row.
+        std::fill_n(this->part_incident[0], L + 2, 0);
+        std::fill_n(this->part_incident[1], L + 2, 0);
+        this->get_part_incident(!this->has_left_boundary())[lmax_idx] = this->incident;
+    } else { // General case
+        this->incident = left->incident | right->incident;
+        if (this->has_left_boundary()) {
+            compute_part_incident<L>(this->get_part_incident(0), left->get_part_incident(0), right->get_part_incident(0), left->get_cover_level());
+        }
+        if (this->has_middle_boundary()) {
+            if (!this->has_right_boundary()) {
+                compute_part_incident<L>(this->get_part_incident(1), right->get_part_incident(0), left->get_part_incident(1), right->get_cover_level());
+            }
+            if (!this->has_left_boundary()) {
+                compute_part_incident<L>(this->get_part_incident(0), left->get_part_incident(1), right->get_part_incident(0), left->get_cover_level());
+            }
+        }
+        if (this->has_right_boundary()) {
+            compute_part_incident<L>(this->get_part_incident(1), right->get_part_incident(1), left->get_part_incident(1), right->get_cover_level());
+        }
+    }
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::find_first_label_cover(int i) {
+    if (i < this->cover_plus || i == -1) {
+        return;
+    }
+    if (this->cover_level < i || this->last_uncover >= i) {
+        for (int side = 0; side < 2; side++) {
+            LevelMask* part_incident = this->get_part_incident(side);
+            or_row_range(&part_incident[i + 1], part_incident, 0, i + 1);
+            std::fill(part_incident, part_incident + (i + 1), 0);
+        }
+    }
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::find_first_label_uncover(int i) {
+    if (i < this->cover_plus || i == -1) {
+        return;
+    }
+    if (this->cover_level <= i) {
+        this->last_uncover = i;
+        for (int side = 0; side < 2; side++) {
+            LevelMask* part_incident = this->get_part_incident(side);
+            or_row_range(&part_incident[0], part_incident, 1, i + 2);
+            std::fill(part_incident + 1, part_incident + (i + 2), 0);
+        }
+    }
+}
+
+template<int L, class P, class F>
+LevelMask* TwoEdgeCluster<L,P,F>::get_part_incident(int side) {
+    return this->part_incident[side != this->part_swapped];
+}
+
+template<int L, class P, class F>
+LevelMask TwoEdgeCluster<L,P,F>::get_incident() {
+    static_assert(F::find_first_label, "find first label is disabled");
+    assert(!this->dirty);
+    return this->incident;
+}
+
+// Walks down from *this* without splitting or merging any cluster. Pending cover tags
+// never change incident, so only pending flips have to be followed: a cluster's children
+// and sides are swapped if the unpushed flips on it and its ancestors add up to odd.
+template<int L, class P, class F>
+std::tuple<TwoEdgeCluster<L,P,F>*,VertexLabel<L,P,F>*> TwoEdgeCluster<L,P,F>::find_first_label(int u, int v, int level) {
+    static_assert(F::find_first_label, "find first label is disabled");
+    assert(!this->dirty);
+    TwoEdgeCluster* node = this;
+    bool swapped = this->is_flipped();
+
+    while (true) {
+        // u is now leftmost of this cluster.
+        int u_is_right = node->boundary_vertices_id[!swapped] == u;
+        VertexLabel<L,P,F>* close_vertex = node->vertex[u_is_right != swapped];
+        VertexLabel<L,P,F>* far_vertex = node->vertex[u_is_right == swapped];
+        if (close_vertex && get_bit(close_vertex->levels, level)) {
+            return std::make_tuple(node, close_vertex);
+        } else if (far_vertex && get_bit(far_vertex->levels, level)) {
+            return std::make_tuple(node, far_vertex);
+        } else if (!node->get_child(0) || !node->get_child(1)) {
+            return std::make_tuple(node, nullptr);
+        }
+
+        TwoEdgeCluster* left_child = node->get_child(swapped);
+        TwoEdgeCluster* right_child = node->get_child(!swapped);
+        bool left_swapped = left_child->is_flipped() != swapped;
+        bool right_swapped = right_child->is_flipped() != swapped;
+        int left_ids[2] = { left_child->boundary_vertices_id[left_swapped], left_child->boundary_vertices_id[!left_swapped] };
+        int right_ids[2] = { right_child->boundary_vertices_id[right_swapped], right_child->boundary_vertices_id[!right_swapped] };
+
+        bool close_is_left;
+        int index;
+        if (left_ids[0] == u && left_ids[0] != left_ids[1]) {
+            //u left
+            close_is_left = true;
+            index = 0;
+        } else if (right_ids[1] == u && right_ids[0] != right_ids[1]) {
+            //u right
+            close_is_left = false;
+            index = 1;
+        } else {
+            // u middle. 
+            close_is_left = left_child->is_point();
+            index = left_child->is_point() ? 1 : 0;
+        }
+        TwoEdgeCluster* close_child = close_is_left ? left_child : right_child;
+        TwoEdgeCluster* far_child = close_is_left ? right_child : left_child;
+        int* close_ids = close_is_left ? left_ids : right_ids;
+        int* far_ids = close_is_left ? right_ids : left_ids;
+
+        if (get_bit(close_child->incident, level)) {
+            u = close_ids[index];
+            v = close_ids[!index];
+            node = close_child;
+            swapped = close_is_left ? left_swapped : right_swapped;
+        } else if (get_bit(far_child->incident, level)) {
+            if (close_child->is_point()) {
+                index = !index;
+            }    
+            u = far_ids[index];
+            v = far_ids[!index];
+            node = far_child;
+            swapped = close_is_left ? right_swapped : left_swapped;
+        } else {
+            //Nothing exists
+            return std::make_tuple(nullptr, nullptr);
+        }
+    }
+}
@@ -0,0 +1,225 @@
+#include "two_edge_cluster.h"
+#include <algorithm>
+#include <climits>
+
+// The weight counterparts of the LevelMask helpers in find_first_label.hpp: a row holds a
+// weight per level instead of a bit, INT_MAX for none, and or becomes min.
+
+template<int L>
+void min_row(int* target_row, const int* source_row) {
+    for (int j = 0; j < L; j++) {
+        target_row[j] = std::min(target_row[j], source_row[j]);
+    }
+}
+
+// Mins row i of source, restricted to levels below i - 1, into target_row.
+template<int L>
+void min_diagonal(int* target_row, const int (*source)[L]) {
+    for (int i = 1; i < L + 2; i++) {
+        for (int j = 0; j < std::min(i, L); j++) {
+            target_row[j] = std::min(target_row[j], source[i][j]);
+        }
+    }
+}
+
+template<int L>
+void min_row_range(int* target_row, const int (*source)[L], int start, int end) {
+    for (int i = start; i < end; i++) {
+        min_row<L>(target_row, source[i]);
+    }
+}
+
+template<int L>
+void clear_weights_from(int* row, int pos) {
+    for (int j = std::max(pos, 0); j < L; j++) {
+        row[j] = INT_MAX;
+    }
+}
+
+template<int L>
+void compute_part_lightest(int (*target)[L], const int (*owner)[L], const int (*other)[L], int cover_level) {
+    int cover_level_idx = cover_level + 1;
+
+    // Rows below the cover level come from the other child, rows above from the owner.
+    std::copy_n(&other[0][0], cover_level_idx * L, &target[0][0]);
+    std::copy_n(&owner[cover_level_idx][0], (L + 2 - cover_level_idx) * L, &target[cover_level_idx][0]);
+    min_row_range<L>(target[cover_level_idx], other, cover_level_idx, L + 2);
+}
+
+template<int L, class P, class F>
+int (*TwoEdgeCluster<L,P,F>::get_part_lightest(int side))[L] {
+    return this->lightest.part_incident[side != this->part_swapped];
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::create_find_lightest_label(TreeEdgeData* edge, None*, None*) {
+    int cover_level_idx = edge->level + 1;
+    int lmax_idx = this->l_max + 1;
+
+    int label[2][L];
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < L; j++) {
+            label[i][j] = this->vertex[i] ? this->vertex[i]->lightest(j) : INT_MAX;
+        }
+    }
+
+    if (this->get_num_boundary_vertices() == 1) {
+        if (this->has_left_boundary()) {
+            clear_weights_from<L>(label[1], this->cover_level + 1);
+        } else {
+            clear_weights_from<L>(label[0], this->cover_level + 1);
+        }
+        std::copy_n(label[0], L, this->lightest.incident);
+        min_row<L>(this->lightest.incident, label[1]);
+        std::copy_n(this->lightest.incident, L, this->get_part_lightest(!this->has_left_boundary())[lmax_idx]);
+    } else if (this->get_num_boundary_vertices() == 2) {
+        std::copy_n(label[0], L, this->lightest.incident);
+        min_row<L>(this->lightest.incident, label[1]);
+        std::copy_n(label[0], L, this->get_part_lightest(0)[lmax_idx]);
+        std::copy_n(label[1], L, this->get_part_lightest(0)[cover_level_idx]);
+        std::copy_n(label[1], L, this->get_part_lightest(1)[lmax_idx]);
+        std::copy_n(label[0], L, this->get_part_lightest(1)[cover_level_idx]);
+    }
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::destroy_find_lightest_label(TreeEdgeData* edge, None*, None*) {
+    std::fill_n(this->lightest.incident, L, INT_MAX);
+    std::fill_n(&this->lightest.part_incident[0][0][0], 2 * (L + 2) * L, INT_MAX);
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::merge_find_lightest_label(TwoEdgeCluster* left, TwoEdgeCluster* right) {
+    int lmax_idx = this->l_max + 1;
+
+    if (this->get_num_boundary_vertices() == 1 && !this->has_middle_boundary()) { // Off the path
+        if (this->has_left_boundary()) {
+            std::copy_n(right->lightest.incident, L, this->lightest.incident);
+            clear_weights_from<L>(this->lightest.incident, left->get_cover_level() + 1);
+            min_diagonal<L>(this->lightest.incident, left->get_part_lightest(0));
+        } else if (this->has_right_boundary()) {
+            std::copy_n(left->lightest.incident, L, this->lightest.incident);
+            clear_weights_from<L>(this->lightest.incident, right->get_cover_level() + 1);
+            min_diagonal<L>(this->lightest.incident, right->get_part_lightest(1));
+        }
+
+        std::fill_n(&this->lightest.part_incident[0][0][0], 2 * (L + 2) * L, INT_MAX);
+        std::copy_n(this->lightest.incident, L, this->get_part_lightest(!this->has_left_boundary())[lmax_idx]);
+    } else { // General case
+        std::copy_n(left->lightest.incident, L, this->lightest.incident);
+        min_row<L>(this->lightest.incident, right->lightest.incident);
+        if (this->has_left_boundary()) {
+            compute_part_lightest<L>(this->get_part_lightest(0), left->get_part_lightest(0), right->get_part_lightest(0), left->get_cover_level());
+        }
+        if (this->has_middle_boundary()) {
+            if (!this->has_right_boundary()) {
+                compute_part_lightest<L>(this->get_part_lightest(1), right->get_part_lightest(0), left->get_part_lightest(1), right->get_cover_level());
+            }
+            if (!this->has_left_boundary()) {
+                compute_part_lightest<L>(this->get_part_lightest(0), left->get_part_lightest(1), right->get_part_lightest(0), left->get_cover_level());
+            }
+        }
+        if (this->has_right_boundary()) {
+            compute_part_lightest<L>(this->get_part_lightest(1), right->get_part_lightest(1), left->get_part_lightest(1), right->get_cover_level());
+        }
+    }
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::find_lightest_label_cover(int i) {
+    if (i < this->cover_plus || i == -1) {
+        return;
+    }
+    if (this->cover_level < i || this->last_uncover >= i) {
+        for (int side = 0; side < 2; side++) {
+            int (*part)[L] = this->get_part_lightest(side);
+            min_row_range<L>(part[i + 1], part, 0, i + 1);
+            std::fill_n(&part[0][0], (i + 1) * L, INT_MAX);
+        }
+    }
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::find_lightest_label_uncover(int i) {
+    if (i < this->cover_plus || i == -1) {
+        return;
+    }
+    if (this->cover_level <= i) {
+        for (int side = 0; side < 2; side++) {
+            int (*part)[L] = this->get_part_lightest(side);
+            min_row_range<L>(part[0], part, 1, i + 2);
+            std::fill_n(&part[1][0], (i + 1) * L, INT_MAX);
+        }
+    }
+}
+
+// A vertex with a label on level at most as heavy as the lightest one reachable from u, or
+// nullptr. Walks down as find_first_label does, into a vertex or child with a weight at
+// most that of this cluster. A child's weight may come from a label that is not reachable,
+// like the bits find_first_label follows, so the label found need not be reachable either.
+template<int L, class P, class F>
+VertexLabel<L,P,F>* TwoEdgeCluster<L,P,F>::find_lightest_label(int u, int level) {
+    static_assert(F::find_lightest_label, "find lightest label is disabled");
+    assert(!this->dirty);
+    int weight = this->lightest.incident[level];
+    if (weight == INT_MAX) {
+        return nullptr;
+    }
+    TwoEdgeCluster* node = this;
+    bool swapped = this->is_flipped();
+
+    while (true) {
+        // u is now leftmost of this cluster.
+        int u_is_right = node->boundary_vertices_id[!swapped] == u;
+        VertexLabel<L,P,F>* close_vertex = node->vertex[u_is_right != swapped];
+        VertexLabel<L,P,F>* far_vertex = node->vertex[u_is_right == swapped];
+        if (close_vertex && close_vertex->lightest(level) <= weight) {
+            return close_vertex;
+        } else if (far_vertex && far_vertex->lightest(level) <= weight) {
+            return far_vertex;
+        } else if (!node->get_child(0) || !node->get_child(1)) {
+            assert(false);
+            return nullptr;
+        }
+
+        TwoEdgeCluster* left_child = node->get_child(swapped);
+        TwoEdgeCluster* right_child = node->get_child(!swapped);
+        bool left_swapped = left_child->is_flipped() != swapped;
+        bool right_swapped = right_child->is_flipped() != swapped;
+        int left_ids[2] = { left_child->boundary_vertices_id[left_swapped], left_child->boundary_vertices_id[!left_swapped] };
+        int right_ids[2] = { right_child->boundary_vertices_id[right_swapped], right_child->boundary_vertices_id[!right_swapped] };
+
+        bool close_is_left;
+        int index;
+        if (left_ids[0] == u && left_ids[0] != left_ids[1]) {
+            close_is_left = true;
+            index = 0;
+        } else if (right_ids[1] == u && right_ids[0] != right_ids[1]) {
+            close_is_left = false;
+            index = 1;
+        } else {
+            close_is_left = left_child->is_point();
+            index = left_child->is_point() ? 1 : 0;
+        }
+        TwoEdgeCluster* close_child = close_is_left ? left_child : right_child;
+        TwoEdgeCluster* far_child = close_is_left ? right_child : left_child;
+        int* close_ids = close_is_left ? left_ids : right_ids;
+        int* far_ids = close_is_left ? right_ids : left_ids;
+
+        if (close_child->lightest.incident[level] <= weight) {
+            u = close_ids[index];
+            node = close_child;
+            swapped = close_is_left ? left_swapped : right_swapped;
+        } else if (far_child->lightest.incident[level] <= weight) {
+            if (close_child->is_point()) {
+                index = !index;
+            }
+            u = far_ids[index];
+            node = far_child;
+            swapped = close_is_left ? right_swapped : left_swapped;
+        } else {
+            assert(false);
+            return nullptr;
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include "two_edge_cluster.h"
+
+
+
+template<int L, class P, class F>
+int TwoEdgeCluster<L,P,F>::get_size(int i) {
+    static_assert(F::find_size, "find size is disabled");
+    assert(!this->dirty);
+    return this->size[i];
+}
+
+template<int L, class P, class F>
+P& TwoEdgeCluster<L,P,F>::get_part_size(int side) {
+    return this->part_size[side != this->part_swapped];
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::create_find_size(TreeEdgeData* edge_data, None* left, None* right)  {
+    int lmax = TwoEdgeCluster::get_l_max();
+    int lmax_idx = lmax + 1;
+    
+    int cover_level = edge_data->level;
+    int cover_level_idx = cover_level + 1;
+    
+    if (this->is_path()) {
+        std::fill_n(this->size, lmax, 2);
+        for (int i = 0; i < 2; i++) {
+            //Fill the row of the coverlevel
+            this->get_part_size(i).fill_row(cover_level_idx, 1);
+            //Fill the row of lmax
+            this->get_part_size(i).fill_row(lmax_idx, 1);
+        }
+        
+    } else if (this->get_num_boundary_vertices() == 1) {
+        std::fill(this->size, this->size + (cover_level + 1), 2);
+        std::fill(this->size + (cover_level + 1), this->size + lmax, 1);
+        
+        // There is only a lmax part        
+        this->get_part_size(this->has_right_boundary()).set_row(lmax_idx, this->size);
+    }
+    // Do nothing if num bound is 0.
+    
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::destroy_find_size(TreeEdgeData* edge_data, None* left, None* right)  {
+    int lmax = TwoEdgeCluster::get_l_max();
+    std::fill_n(this->size, lmax, 0);
+    this->part_size[0].clear();
+    this->part_size[1].clear();
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::merge_find_size(TwoEdgeCluster* left, TwoEdgeCluster* right) {
+
+    int lmax = TwoEdgeCluster::get_l_max();
+    int lmax_idx = lmax + 1;
+    
+    //Heterogenous children into point cluster
+    if (this->get_num_boundary_vertices() == 1 && !this->has_middle_boundary()) {
+        // Handle this->size. Delete data and write new.
+        if (this->has_left_boundary()) { 
+            //left->cover_level() correct as left -- mid is the cluster path of left
+            int cover_level = left->get_cover_level();
+            for (int j = 0; j < lmax; j++) {
+                this->size[j] = j <= cover_level ? right->size[j] - 1 : 0;
+            }
+            left->get_part_size(0).add_lower_triangle(this->size);
+        } else if (this->has_right_boundary()) {
+            int cover_level = right->get_cover_level();
+            for (int j = 0; j < lmax; j++) {
+                this->size[j] = j <= cover_level ? left->size[j] - 1 : 0;
+            }
+            right->get_part_size(1).add_lower_triangle(this->size);
+        }
+
+        // Copy size into partsize row: lmax, the only non-zero row.
+        this->part_size[0].clear();
+        this->part_size[1].clear();
+        this->get_part_size(!this->has_left_boundary()).set_row(lmax_idx, this->size);
+    //The general case
+    } else {
+        // Compute size
+        for (int i = 0; i < lmax; i++) {
+            // As central vertex in both, subtract 1 from every point size.
+            this->size[i] = left->size[i] + right->size[i] - 1;
+        }
+
+        if (this->has_left_boundary()) {
+            this->get_part_size(0).combine(left->get_part_size(0), right->get_part_size(0), left->get_cover_level() + 1);
+        }
+        if (this->has_middle_boundary()) {
+            if (!this->has_right_boundary()) {
+                this->get_part_size(1).combine(right->get_part_size(0), left->get_part_size(1), right->get_cover_level() + 1);
+            }
+            if (!this->has_left_boundary()) {
+                this->get_part_size(0).combine(left->get_part_size(1), right->get_part_size(0), left->get_cover_level() + 1);
+            }
+        }
+        if (this->has_right_boundary()) {
+            this->get_part_size(1).combine(right->get_part_size(1), left->get_part_size(1), right->get_cover_level() + 1);
+        }
+    }
+}
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::find_size_cover(int i) {
+    if (i < this->cover_plus) {
+        return;
+    }
+    if (this->cover_level < i) { 
+        this->part_size[0].collapse_rows(i + 1, 0, i + 1);
+        this->part_size[1].collapse_rows(i + 1, 0, i + 1);
+    }
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::find_size_uncover(int i) {
+    if (i < this->cover_plus) {
+        return;
+    }
+    if (this->cover_level <= i) {
+        // this->last_uncover = i;
+        this->part_size[0].collapse_rows(0, 1, i + 2);
+        this->part_size[1].collapse_rows(0, 1, i + 2);
+    }
+}
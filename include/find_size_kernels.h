@@ -0,0 +1,226 @@
+#ifndef FIND_SIZE_KERNELS
+#define FIND_SIZE_KERNELS
+
+#include <algorithm>
+
+#ifdef FIND_SIZE_KERNELS_SELECTABLE
+#include <atomic>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FIND_SIZE_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+// Row kernels behind TwoEdgeCluster's find size matrices.
+// Rows are W ints long and stored back to back, W is the level bound of the cluster, so
+// every trip count is known at compile time. The implementation is picked on first use:
+// AVX-512 or AVX2 when the cpu supports it, otherwise a scalar fallback that inlines into
+// the caller. The pick is a function-local constant, so graphs on separate threads, or
+// built during static initialization of another translation unit, share no mutable state.
+namespace find_size_kernels {
+
+enum class Isa { Scalar, AVX2, AVX512 };
+
+template<int W>
+inline void sum_rows_scalar(int* target, const int* source, int num_rows) {
+    for (int i = 0; i < num_rows; i++) {
+        const int* source_row = source + i * W;
+        for (int j = 0; j < W; j++) {
+            target[j] += source_row[j];
+        }
+    }
+}
+
+template<int W>
+inline void sum_lower_triangle_scalar(int* target, const int* source) {
+    for (int i = 1; i < W + 2; i++) {
+        const int* source_row = source + i * W;
+        int end = std::min(i, W);
+        for (int j = 0; j < end; j++) {
+            target[j] += source_row[j];
+        }
+    }
+}
+
+#ifdef FIND_SIZE_KERNELS_X86
+
+// Lanes [0, n) set, n is clamped to the vector length.
+__attribute__((target("avx2")))
+inline __m256i lane_mask_avx2(int n) {
+    const __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(n), iota);
+}
+
+template<int W>
+__attribute__((target("avx2")))
+void sum_rows_avx2(int* target, const int* source, int num_rows) {
+    // Accumulate a column block over all rows in a register, then write it back once.
+    for (int j = 0; j < W; j += 8) {
+        __m256i mask = lane_mask_avx2(W - j);
+        __m256i acc = _mm256_maskload_epi32(target + j, mask);
+        for (int i = 0; i < num_rows; i++) {
+            acc = _mm256_add_epi32(acc, _mm256_maskload_epi32(source + i * W + j, mask));
+        }
+        _mm256_maskstore_epi32(target + j, mask, acc);
+    }
+}
+
+template<int W>
+__attribute__((target("avx2")))
+void sum_lower_triangle_avx2(int* target, const int* source) {
+    for (int j = 0; j < W; j += 8) {
+        __m256i acc = _mm256_maskload_epi32(target + j, lane_mask_avx2(W - j));
+        // Rows at or above column j contribute nothing to this block.
+        for (int i = j + 1; i < W + 2; i++) {
+            __m256i mask = lane_mask_avx2(std::min(i, W) - j);
+            acc = _mm256_add_epi32(acc, _mm256_maskload_epi32(source + i * W + j, mask));
+        }
+        _mm256_maskstore_epi32(target + j, lane_mask_avx2(W - j), acc);
+    }
+}
+
+inline __mmask16 lane_mask_avx512(int n) {
+    return n >= 16 ? (__mmask16) 0xFFFF : (__mmask16) ((1u << n) - 1);
+}
+
+template<int W>
+__attribute__((target("avx512f")))
+void sum_rows_avx512(int* target, const int* source, int num_rows) {
+    for (int j = 0; j < W; j += 16) {
+        __mmask16 mask = lane_mask_avx512(W - j);
+        __m512i acc = _mm512_maskz_loadu_epi32(mask, target + j);
+        for (int i = 0; i < num_rows; i++) {
+            acc = _mm512_add_epi32(acc, _mm512_maskz_loadu_epi32(mask, source + i * W + j));
+        }
+        _mm512_mask_storeu_epi32(target + j, mask, acc);
+    }
+}
+
+template<int W>
+__attribute__((target("avx512f")))
+void sum_lower_triangle_avx512(int* target, const int* source) {
+    for (int j = 0; j < W; j += 16) {
+        __mmask16 block_mask = lane_mask_avx512(W - j);
+        __m512i acc = _mm512_maskz_loadu_epi32(block_mask, target + j);
+        for (int i = j + 1; i < W + 2; i++) {
+            __mmask16 mask = lane_mask_avx512(std::min(i, W) - j);
+            acc = _mm512_add_epi32(acc, _mm512_maskz_loadu_epi32(mask, source + i * W + j));
+        }
+        _mm512_mask_storeu_epi32(target + j, block_mask, acc);
+    }
+}
+
+#endif
+
+inline bool supported(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar:
+            return true;
+#ifdef FIND_SIZE_KERNELS_X86
+        case Isa::AVX2:
+            // Needed when the first query runs before the constructors of libgcc.
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        case Isa::AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+// Best implementation supported by this cpu.
+inline Isa best_isa() {
+    if (supported(Isa::AVX512)) {
+        return Isa::AVX512;
+    }
+    if (supported(Isa::AVX2)) {
+        return Isa::AVX2;
+    }
+    return Isa::Scalar;
+}
+
+inline const char* isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2:
+            return "avx2";
+        case Isa::AVX512:
+            return "avx512";
+        default:
+            return "scalar";
+    }
+}
+
+// Adds the rows source[0, num_rows) into target with the given, supported, implementation.
+template<int W>
+inline void sum_rows(Isa isa, int* target, const int* source, int num_rows) {
+    switch (isa) {
+#ifdef FIND_SIZE_KERNELS_X86
+        case Isa::AVX2:
+            return sum_rows_avx2<W>(target, source, num_rows);
+        case Isa::AVX512:
+            return sum_rows_avx512<W>(target, source, num_rows);
+#endif
+        default:
+            return sum_rows_scalar<W>(target, source, num_rows);
+    }
+}
+
+// Adds source[i][j] into target[j] for every row 1 <= i <= W + 1 and column j < i.
+template<int W>
+inline void sum_lower_triangle(Isa isa, int* target, const int* source) {
+    switch (isa) {
+#ifdef FIND_SIZE_KERNELS_X86
+        case Isa::AVX2:
+            return sum_lower_triangle_avx2<W>(target, source);
+        case Isa::AVX512:
+            return sum_lower_triangle_avx512<W>(target, source);
+#endif
+        default:
+            return sum_lower_triangle_scalar<W>(target, source);
+    }
+}
+
+#ifdef FIND_SIZE_KERNELS_SELECTABLE
+// Benchmarks define FIND_SIZE_KERNELS_SELECTABLE for every translation unit of their
+// executable to compare implementations end to end. The pick is then an atomic instead of
+// a constant, so a graph running on another thread never sees a torn value.
+inline std::atomic<Isa>& selected_isa() {
+    static std::atomic<Isa> isa(best_isa());
+    return isa;
+}
+
+// Forces an implementation. Returns false if the cpu lacks support.
+inline bool set_isa(Isa isa) {
+    if (!supported(isa)) {
+        return false;
+    }
+    selected_isa().store(isa, std::memory_order_relaxed);
+    return true;
+}
+#endif
+
+inline Isa get_isa() {
+#ifdef FIND_SIZE_KERNELS_SELECTABLE
+    return selected_isa().load(std::memory_order_relaxed);
+#else
+    static const Isa isa = best_isa();
+    return isa;
+#endif
+}
+
+template<int W>
+inline void sum_rows(int* target, const int* source, int num_rows) {
+    sum_rows<W>(get_isa(), target, source, num_rows);
+}
+
+template<int W>
+inline void sum_lower_triangle(int* target, const int* source) {
+    sum_lower_triangle<W>(get_isa(), target, source);
+}
+
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef INCREMENTAL_TWO_EDGE_CONNECTED
+#define INCREMENTAL_TWO_EDGE_CONNECTED
+
+#include "edge.h"
+#include "two_edge_connected.h"
+
+#include <memory>
+#include <vector>
+
+// 2-edge connectivity for insert heavy streams. While edges are only inserted, the
+// 2-edge-connected components are kept with union-find over a spanning forest, so an
+// insert is near-constant amortized time and touches no top tree. The first operation
+// that needs the full structure (remove, find_bridge, expose) replays the inserted
+// edges into a TwoEdgeConnectivity, which handles everything from then on.
+// Handles returned by insert stay valid across that switch.
+template<int L = 32, class P = DensePartSize<L>, class F = AllFeatures>
+class IncrementalTwoEdgeConnectivity {
+    TwoEdgeConnectivity<L,P,F> graph;
+    bool materialized = false;
+    std::vector<std::shared_ptr<EdgeData>> pending; // Inserted before materialize, in order
+
+    // Vertices are grouped into 2-edge-connected components, whose representatives
+    // form a forest through 'parent'. A bridge joins a representative and its parent.
+    std::vector<int> two_edge_component;
+    std::vector<int> parent;
+    // Connected components over the representatives, the root of a tree is the set id.
+    std::vector<int> component;
+    std::vector<int> component_size;
+    // Marks for finding the lowest common ancestor, reused between inserts.
+    std::vector<int> last_visit;
+    int visit_iteration = 0;
+    std::vector<int> path[2];
+
+    int find_two_edge_component(int);
+    int find_component(int);
+    void make_root(int);
+    void merge_path(int, int);
+    void add_edge(int, int);
+    void materialize();
+
+    public:
+    std::shared_ptr<EdgeData> insert(int, int);
+    void remove(std::shared_ptr<EdgeData>);
+    bool two_edge_connected(int, int);
+    TreeEdgeData* find_bridge(int, int);
+    bool is_materialized() { return this->materialized; };
+
+    TwoEdgeCluster<L,P,F>* expose(int u) {
+        this->materialize();
+        return this->graph.expose(u);
+    };
+    TwoEdgeCluster<L,P,F>* expose(int u, int v) {
+        this->materialize();
+        return this->graph.expose(u, v);
+    };
+    TwoEdgeCluster<L,P,F>* deexpose(int u) {
+        return this->graph.deexpose(u);
+    };
+    TwoEdgeCluster<L,P,F>* deexpose(int u, int v) {
+        return this->graph.deexpose(u, v);
+    };
+
+    IncrementalTwoEdgeConnectivity(int size);
+};
+
+#include "incremental_two_edge_connected.hpp"
+
+#endif
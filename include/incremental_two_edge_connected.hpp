@@ -0,0 +1,172 @@
+#include "incremental_two_edge_connected.h"
+
+template<int L, class P, class F>
+IncrementalTwoEdgeConnectivity<L,P,F>::IncrementalTwoEdgeConnectivity(int size) : graph(size) {
+    this->two_edge_component = std::vector<int>(size);
+    this->parent = std::vector<int>(size, -1);
+    this->component = std::vector<int>(size);
+    this->component_size = std::vector<int>(size, 1);
+    this->last_visit = std::vector<int>(size, 0);
+    for (int i = 0; i < size; i++) {
+        this->two_edge_component[i] = i;
+        this->component[i] = i;
+    }
+}
+
+template<int L, class P, class F>
+int IncrementalTwoEdgeConnectivity<L,P,F>::find_two_edge_component(int v) {
+    if (v == -1) {
+        return -1;
+    }
+    int root = v;
+    while (this->two_edge_component[root] != root) {
+        root = this->two_edge_component[root];
+    }
+    while (this->two_edge_component[v] != root) {
+        int next = this->two_edge_component[v];
+        this->two_edge_component[v] = root;
+        v = next;
+    }
+    return root;
+}
+
+template<int L, class P, class F>
+int IncrementalTwoEdgeConnectivity<L,P,F>::find_component(int v) {
+    v = this->find_two_edge_component(v);
+    int root = v;
+    while (this->component[root] != root) {
+        root = this->component[root];
+    }
+    while (this->component[v] != root) {
+        int next = this->component[v];
+        this->component[v] = root;
+        v = next;
+    }
+    return root;
+}
+
+// Reverses the parent pointers from representative v up to its root, making v the root.
+template<int L, class P, class F>
+void IncrementalTwoEdgeConnectivity<L,P,F>::make_root(int v) {
+    int root = v;
+    int child = -1;
+    while (v != -1) {
+        int next = this->find_two_edge_component(this->parent[v]);
+        this->parent[v] = child;
+        this->component[v] = root;
+        child = v;
+        v = next;
+    }
+    this->component_size[root] = this->component_size[child];
+}
+
+// Joins every 2-edge-connected component on the forest path between a and b.
+template<int L, class P, class F>
+void IncrementalTwoEdgeConnectivity<L,P,F>::merge_path(int a, int b) {
+    this->visit_iteration++;
+    this->path[0].clear();
+    this->path[1].clear();
+    int ends[2] = {a, b};
+    int lca = -1;
+    while (lca == -1) {
+        for (int i = 0; i < 2 && lca == -1; i++) {
+            if (ends[i] == -1) {
+                continue;
+            }
+            int v = this->find_two_edge_component(ends[i]);
+            this->path[i].push_back(v);
+            if (this->last_visit[v] == this->visit_iteration) {
+                lca = v;
+            }
+            this->last_visit[v] = this->visit_iteration;
+            ends[i] = this->parent[v];
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        for (int v : this->path[i]) {
+            this->two_edge_component[v] = lca;
+            if (v == lca) {
+                break;
+            }
+        }
+    }
+}
+
+template<int L, class P, class F>
+void IncrementalTwoEdgeConnectivity<L,P,F>::add_edge(int a, int b) {
+    a = this->find_two_edge_component(a);
+    b = this->find_two_edge_component(b);
+    if (a == b) {
+        return;
+    }
+    int component_a = this->find_component(a);
+    int component_b = this->find_component(b);
+    if (component_a != component_b) {
+        // New bridge, hang the smaller tree below the larger.
+        if (this->component_size[component_a] > this->component_size[component_b]) {
+            std::swap(a, b);
+            std::swap(component_a, component_b);
+        }
+        this->make_root(a);
+        this->parent[a] = b;
+        this->component[a] = b;
+        this->component_size[component_b] += this->component_size[a];
+    } else {
+        this->merge_path(a, b);
+    }
+}
+
+template<int L, class P, class F>
+void IncrementalTwoEdgeConnectivity<L,P,F>::materialize() {
+    if (this->materialized) {
+        return;
+    }
+    this->materialized = true;
+    for (std::shared_ptr<EdgeData>& edge : this->pending) {
+        this->graph.insert(edge);
+    }
+    // Not needed anymore, release the memory.
+    this->pending = std::vector<std::shared_ptr<EdgeData>>();
+    this->two_edge_component = std::vector<int>();
+    this->parent = std::vector<int>();
+    this->component = std::vector<int>();
+    this->component_size = std::vector<int>();
+    this->last_visit = std::vector<int>();
+    this->path[0] = std::vector<int>();
+    this->path[1] = std::vector<int>();
+}
+
+template<int L, class P, class F>
+std::shared_ptr<EdgeData> IncrementalTwoEdgeConnectivity<L,P,F>::insert(int u, int v) {
+    if (this->materialized) {
+        return this->graph.insert(u, v);
+    }
+    if (u == v) {
+        return nullptr;
+    }
+    // Type and level are filled in by materialize.
+    std::shared_ptr<EdgeData> edge = std::make_shared<EdgeData>(u, v);
+    this->pending.push_back(edge);
+    this->add_edge(u, v);
+    return edge;
+}
+
+template<int L, class P, class F>
+void IncrementalTwoEdgeConnectivity<L,P,F>::remove(std::shared_ptr<EdgeData> edge) {
+    this->materialize();
+    this->graph.remove(edge);
+}
+
+template<int L, class P, class F>
+bool IncrementalTwoEdgeConnectivity<L,P,F>::two_edge_connected(int u, int v) {
+    if (this->materialized) {
+        return this->graph.two_edge_connected(u, v);
+    }
+    return this->find_two_edge_component(u) == this->find_two_edge_component(v);
+}
+
+template<int L, class P, class F>
+TreeEdgeData* IncrementalTwoEdgeConnectivity<L,P,F>::find_bridge(int u, int v) {
+    this->materialize();
+    return this->graph.find_bridge(u, v);
+}
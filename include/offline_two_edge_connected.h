@@ -0,0 +1,43 @@
+#ifndef OFFLINE_TWO_EDGE_CONNECTED
+#define OFFLINE_TWO_EDGE_CONNECTED
+
+#include <vector>
+
+// 2-edge connectivity for an update and query sequence known in advance. Record the
+// sequence with insert, remove and two_edge_connected, then solve answers all queries.
+//
+// solve divides the queries in halves recursively. Edges present during a whole range of
+// queries are contracted: 2-edge-connected components become single vertices, and the
+// resulting forest of bridges is pruned to the vertices the range still touches, with
+// chains of bridges shortened to one. A range with k updates and queries is therefore
+// handled on a graph of O(k) size, O((m + q) log q) in total.
+class OfflineTwoEdgeConnectivity {
+    struct Edge {
+        int endpoints[2];
+        int begin; // Alive for the queries [begin, end), end is -1 until removed
+        int end;
+    };
+
+    int num_vertices;
+    std::vector<Edge> edges;
+    std::vector<int> query_endpoints[2];
+    // Query endpoints renamed to the contracted vertices of the current range
+    std::vector<int> mapped_query_endpoints[2];
+
+    void solve(int, int, int, std::vector<Edge>&, std::vector<bool>&);
+    int contract(int, int, int, std::vector<Edge>&, std::vector<Edge>&);
+
+    public:
+    // Returns an id for remove. Self-loops are accepted and ignored.
+    int insert(int, int);
+    void remove(int);
+    // Returns the index of the answer in the result of solve.
+    int two_edge_connected(int, int);
+    std::vector<bool> solve();
+
+    int num_queries() { return this->query_endpoints[0].size(); };
+
+    OfflineTwoEdgeConnectivity(int size) : num_vertices(size) {};
+};
+
+#endif
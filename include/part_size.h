@@ -0,0 +1,68 @@
+#ifndef PART_SIZE
+#define PART_SIZE
+
+#include <vector>
+
+// Storage of one side of a TwoEdgeCluster's part_size matrix. The matrix has l_max + 2
+// rows, row i holds the sizes of the vertices whose path to the boundary vertex has cover
+// level i - 1, one column per level. TwoEdgeCluster only touches it through the
+// operations below, so either representation can be picked with its P parameter.
+
+// Flat (L + 2) x L matrix stored inline. Operations run the find size kernels over whole rows.
+template<int L>
+class DensePartSize {
+    int data[(L + 2) * L];
+
+    int* row(int);
+    const int* row(int) const;
+
+    public:
+    int get(int row, int column) const;
+    void clear();
+    void fill_row(int row, int value);
+    void set_row(int row, const int* values);
+    // Adds the rows [start, end) into row target and zeroes them.
+    void collapse_rows(int target, int start, int end);
+    // Rows below row_idx come from other, rows above from owner. Row row_idx is the sum
+    // of owner's row and other's rows from row_idx and up, minus the shared vertex.
+    void combine(const DensePartSize& owner, const DensePartSize& other, int row_idx);
+    // Adds get(i, j) into target[j] for all rows i > j.
+    void add_lower_triangle(int* target) const;
+    // Bytes used by this side, including anything on the heap.
+    std::size_t memory_usage() const;
+
+    DensePartSize();
+};
+
+// Only the non-zero rows are stored, in increasing order, in a heap buffer. Rows are
+// cut to a common width, every column from width - 1 and up holds the same value.
+// Columns above the highest cover level in a cluster only count single vertices, so
+// in practice a side holds one or two rows of a few columns.
+template<int L>
+class SparsePartSize {
+    static_assert(L + 2 < 64, "rows are tracked in a 64 bit mask");
+
+    unsigned long long rows = 0; // Bit i is set if row i is stored
+    int width = 1;
+    std::vector<int> data;
+
+    static unsigned long long row_range(int start, int end);
+    int position(int) const;
+    const int* row(int) const;
+    void widen(int);
+    void assign(unsigned long long, const int* const*);
+
+    public:
+    int get(int row, int column) const;
+    void clear();
+    void fill_row(int row, int value);
+    void set_row(int row, const int* values);
+    void collapse_rows(int target, int start, int end);
+    void combine(const SparsePartSize& owner, const SparsePartSize& other, int row_idx);
+    void add_lower_triangle(int* target) const;
+    std::size_t memory_usage() const;
+};
+
+#include "part_size.hpp"
+
+#endif
@@ -0,0 +1,247 @@
+#include "part_size.h"
+#include "find_size_kernels.h"
+
+#include <algorithm>
+#include <cassert>
+
+template<int L>
+DensePartSize<L>::DensePartSize() {
+    this->clear();
+}
+
+template<int L>
+int* DensePartSize<L>::row(int i) {
+    return this->data + i * L;
+}
+
+template<int L>
+const int* DensePartSize<L>::row(int i) const {
+    return this->data + i * L;
+}
+
+template<int L>
+int DensePartSize<L>::get(int i, int column) const {
+    return this->row(i)[column];
+}
+
+template<int L>
+void DensePartSize<L>::clear() {
+    std::fill_n(this->data, (L + 2) * L, 0);
+}
+
+template<int L>
+void DensePartSize<L>::fill_row(int i, int value) {
+    std::fill_n(this->row(i), L, value);
+}
+
+template<int L>
+void DensePartSize<L>::set_row(int i, const int* values) {
+    std::copy_n(values, L, this->row(i));
+}
+
+template<int L>
+void DensePartSize<L>::collapse_rows(int target, int start, int end) {
+    if (start >= end) {
+        return;
+    }
+    find_size_kernels::sum_rows<L>(this->row(target), this->row(start), end - start);
+    std::fill(this->row(start), this->row(end), 0);
+}
+
+template<int L>
+void DensePartSize<L>::combine(const DensePartSize& owner, const DensePartSize& other, int row_idx) {
+    // Rows above the cover level come from the owner, rows below from the other child.
+    std::copy_n(other.data, row_idx * L, this->data);
+    std::copy(owner.row(row_idx), owner.row(L + 2), this->row(row_idx));
+
+    find_size_kernels::sum_rows<L>(this->row(row_idx), other.row(row_idx), L + 2 - row_idx);
+    // Subtract 1, as it is otherwise counted twice.
+    int* target_row = this->row(row_idx);
+    for (int j = 0; j < L; j++) {
+        target_row[j] -= 1;
+    }
+}
+
+template<int L>
+void DensePartSize<L>::add_lower_triangle(int* target) const {
+    // Start from 1, i.e. row 0, as row -1 is 0s.
+    find_size_kernels::sum_lower_triangle<L>(target, this->data);
+}
+
+template<int L>
+std::size_t DensePartSize<L>::memory_usage() const {
+    return sizeof(*this);
+}
+
+
+
+template<int L>
+unsigned long long SparsePartSize<L>::row_range(int start, int end) {
+    if (start >= end) {
+        return 0;
+    }
+    return ((1ull << end) - 1) & ~((1ull << start) - 1);
+}
+
+template<int L>
+int SparsePartSize<L>::position(int i) const {
+    return __builtin_popcountll(this->rows & ((1ull << i) - 1));
+}
+
+template<int L>
+const int* SparsePartSize<L>::row(int i) const {
+    return this->data.data() + this->position(i) * this->width;
+}
+
+// Repeats the last column of every stored row up to new_width.
+template<int L>
+void SparsePartSize<L>::widen(int new_width) {
+    int old_width = this->width;
+    if (new_width <= old_width) {
+        return;
+    }
+    int count = __builtin_popcountll(this->rows);
+    this->data.resize(count * new_width);
+    // Back to front, so that no row is overwritten before it is moved.
+    for (int k = count - 1; k >= 0; k--) {
+        for (int j = new_width - 1; j >= 0; j--) {
+            this->data[k * new_width + j] = this->data[k * old_width + std::min(j, old_width - 1)];
+        }
+    }
+    this->width = new_width;
+}
+
+// Stores new_rows, sources[k] holds the width columns of the k'th of them.
+template<int L>
+void SparsePartSize<L>::assign(unsigned long long new_rows, const int* const* sources) {
+    // Sources may point into data, so they are gathered before data is overwritten.
+    int buffer[(L + 2) * L];
+    int count = __builtin_popcountll(new_rows);
+    for (int k = 0; k < count; k++) {
+        std::copy_n(sources[k], this->width, buffer + k * this->width);
+    }
+    this->rows = new_rows;
+    this->data.assign(buffer, buffer + count * this->width);
+}
+
+template<int L>
+int SparsePartSize<L>::get(int i, int column) const {
+    if (!((this->rows >> i) & 1)) {
+        return 0;
+    }
+    return this->row(i)[std::min(column, this->width - 1)];
+}
+
+template<int L>
+void SparsePartSize<L>::clear() {
+    // Keeps the capacity of data, clusters are split and merged again all the time.
+    this->rows = 0;
+    this->width = 1;
+    this->data.clear();
+}
+
+template<int L>
+void SparsePartSize<L>::fill_row(int i, int value) {
+    int values[L];
+    std::fill_n(values, L, value);
+    this->set_row(i, values);
+}
+
+template<int L>
+void SparsePartSize<L>::set_row(int i, const int* values) {
+    int needed_width = 1;
+    for (int j = 1; j < L; j++) {
+        if (values[j] != values[j - 1]) {
+            needed_width = j + 1;
+        }
+    }
+    this->widen(needed_width);
+
+    unsigned long long new_rows = this->rows | (1ull << i);
+    const int* sources[L + 2];
+    int k = 0;
+    for (unsigned long long bits = new_rows; bits; bits &= bits - 1) {
+        int r = __builtin_ctzll(bits);
+        sources[k++] = r == i ? values : this->row(r);
+    }
+    this->assign(new_rows, sources);
+}
+
+template<int L>
+void SparsePartSize<L>::collapse_rows(int target, int start, int end) {
+    unsigned long long collapsed = this->rows & row_range(start, end);
+    if (!collapsed) {
+        return;
+    }
+    int sum[L] = {};
+    for (unsigned long long bits = collapsed | (this->rows & (1ull << target)); bits; bits &= bits - 1) {
+        const int* source = this->row(__builtin_ctzll(bits));
+        for (int j = 0; j < this->width; j++) {
+            sum[j] += source[j];
+        }
+    }
+
+    unsigned long long new_rows = (this->rows & ~collapsed) | (1ull << target);
+    const int* sources[L + 2];
+    int k = 0;
+    for (unsigned long long bits = new_rows; bits; bits &= bits - 1) {
+        int r = __builtin_ctzll(bits);
+        sources[k++] = r == target ? sum : this->row(r);
+    }
+    this->assign(new_rows, sources);
+}
+
+template<int L>
+void SparsePartSize<L>::combine(const SparsePartSize& owner, const SparsePartSize& other, int row_idx) {
+    assert(this != &owner && this != &other);
+    this->width = std::max(owner.width, other.width);
+    this->rows = (other.rows & row_range(0, row_idx)) 
+               | (owner.rows & row_range(row_idx + 1, L + 2)) 
+               | (1ull << row_idx);
+    this->data.resize(__builtin_popcountll(this->rows) * this->width);
+
+    int* target = this->data.data();
+    for (unsigned long long bits = this->rows; bits; bits &= bits - 1) {
+        int r = __builtin_ctzll(bits);
+        if (r != row_idx) {
+            const SparsePartSize& source = r < row_idx ? other : owner;
+            for (int j = 0; j < this->width; j++) {
+                target[j] = source.get(r, j);
+            }
+        } else {
+            // Subtract 1, as it is otherwise counted twice.
+            for (int j = 0; j < this->width; j++) {
+                target[j] = owner.get(r, j) - 1;
+            }
+            for (unsigned long long other_bits = other.rows & row_range(row_idx, L + 2); other_bits; other_bits &= other_bits - 1) {
+                int s = __builtin_ctzll(other_bits);
+                for (int j = 0; j < this->width; j++) {
+                    target[j] += other.get(s, j);
+                }
+            }
+        }
+        target += this->width;
+    }
+}
+
+template<int L>
+void SparsePartSize<L>::add_lower_triangle(int* target) const {
+    // Row 0 has no columns below the diagonal.
+    for (unsigned long long bits = this->rows & ~1ull; bits; bits &= bits - 1) {
+        int r = __builtin_ctzll(bits);
+        const int* source = this->row(r);
+        int end = std::min(r, L);
+        int stored = std::min(end, this->width);
+        for (int j = 0; j < stored; j++) {
+            target[j] += source[j];
+        }
+        for (int j = stored; j < end; j++) {
+            target[j] += source[this->width - 1];
+        }
+    }
+}
+
+template<int L>
+std::size_t SparsePartSize<L>::memory_usage() const {
+    return sizeof(*this) + this->data.capacity() * sizeof(int);
+}
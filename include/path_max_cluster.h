@@ -0,0 +1,48 @@
+#ifndef PATH_MAX_CLUSTER
+#define PATH_MAX_CLUSTER
+
+#include "top_tree.h"
+
+#include <climits>
+#include <memory>
+
+struct WeightedEdgeData;
+
+// Holds its edge, so the top tree keeps the edges of the forest alive.
+struct PathMaxEdge {
+    int weight;
+    std::shared_ptr<WeightedEdgeData> edge;
+};
+
+// The heaviest edge on the cluster path, as in the max weight on path example.
+// Point clusters have none.
+struct PathMaxCluster : Node<PathMaxCluster, PathMaxEdge, None> {
+    int max_weight = INT_MIN;
+    WeightedEdgeData* max_edge = nullptr;
+
+    void create(PathMaxEdge* edge_data, None* left, None* right) {
+        if (this->is_path()) {
+            this->max_weight = edge_data->weight;
+            this->max_edge = edge_data->edge.get();
+        } else {
+            this->max_weight = INT_MIN;
+            this->max_edge = nullptr;
+        }
+    };
+
+    void merge(PathMaxCluster* left, PathMaxCluster* right) {
+        this->max_weight = INT_MIN;
+        this->max_edge = nullptr;
+        if (!this->is_path()) {
+            return;
+        }
+        for (PathMaxCluster* child : { left, right }) {
+            if (child->is_path() && child->max_weight > this->max_weight) {
+                this->max_weight = child->max_weight;
+                this->max_edge = child->max_edge;
+            }
+        }
+    };
+};
+
+#endif
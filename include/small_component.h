@@ -0,0 +1,48 @@
+#ifndef SMALL_COMPONENT
+#define SMALL_COMPONENT
+
+#include "edge.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// A connected component of at most 64 vertices kept as a plain edge list instead of in
+// the top tree. Vertices have local indices, so vertex sets are 64 bit masks and
+// reachability is a bitset search. Bridges and 2-edge-connected components are
+// recomputed from scratch after a change, at the first query.
+struct SmallComponent {
+    static constexpr int max_size = 64;
+
+    std::vector<int> vertices; // Local index to vertex id
+    // Edges have edge_type SmallComponentEdge and extra_data.index[0] set to their position here.
+    std::vector<std::shared_ptr<EdgeData>> edges;
+    std::vector<std::array<std::uint8_t,2>> local_endpoints;
+
+    int add_vertex(int);
+    void add_edge(std::shared_ptr<EdgeData>, int, int);
+    void remove_edge(EdgeData*);
+    // Moves all vertices and edges of other in here, local indices of other are shifted by size().
+    void absorb(SmallComponent&);
+    // Moves the vertices outside 'keep' and their edges to the returned component.
+    // No edge may join 'keep' and the rest.
+    SmallComponent split(std::uint64_t keep);
+
+    // Local vertices reachable from a local vertex.
+    std::uint64_t reachable(int);
+    bool two_edge_connected(int, int);
+    // Local vertices in the 2-edge-connected component of a local vertex.
+    std::uint64_t two_edge_component_of(int);
+
+    int size() { return this->vertices.size(); };
+
+    private:
+    bool stale = true;
+    std::vector<std::uint64_t> two_edge_component; // Per local vertex, its 2-edge-connected component
+
+    void neighbours(std::uint64_t*, std::uint64_t*);
+    void recompute();
+};
+
+#endif
@@ -50,7 +50,8 @@ void InternalNode<C,E,V>::merge_internal() {
 
     this->children[0]->push_flip();
     this->children[1]->push_flip();
-    
+
+    this->num_marked = this->children[0]->num_marked + this->children[1]->num_marked;
     this->merge(
         this->children[0], 
         this->children[1]
@@ -43,6 +43,11 @@ void LeafNode<C,E,V>::merge_internal() {
     E* edge = this->edge->get_data();
     V* left = this->edge->get_endpoint(this->flipped)->get_data();
     V* right = this->edge->get_endpoint(!this->flipped)->get_data();
+    this->num_marked = 0;
+    for (int i = 0; i < 2; i++) {
+        Vertex<C,E,V>* endpoint = this->edge->get_endpoint(i);
+        this->num_marked += endpoint->is_marked() && endpoint->get_first_edge() == this->edge;
+    }
     this->create(edge, left, right);
     return;
 }
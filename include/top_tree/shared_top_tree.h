@@ -0,0 +1,64 @@
+#ifndef SHARED_TOP_TREE
+#define SHARED_TOP_TREE 1
+
+#include "top_tree.h"
+#include <mutex>
+#include <shared_mutex>
+
+// A TopTree shared by many reader threads and some writers. find_root and same_tree take
+// the lock shared and only walk parent pointers, everything else runs inside write, which
+// takes it exclusively. A reader walks at most the splay_depth of the tree, O(log n)
+// levels, per vertex. If a leaf is deeper, the reader takes the lock exclusively instead
+// and answers as TopTree::connected does, which splays the leaf at amortized O(log n) cost
+// and leaves it shallow for the readers after it. So a query costs O(log n) under the
+// shared lock, or amortized O(log n) under the exclusive one.
+template<class C = DefaultC, class E = None, class V = None>
+class SharedTopTree {
+    TopTree<C,E,V> tree;
+    std::shared_mutex mutex;
+
+    public:
+    SharedTopTree(int size) : tree(size) {}
+
+    // The root is only meaningful to compare with other roots found before the next write,
+    // as a writer may restructure the tree right after.
+    C* find_root(int vertex_id) {
+        Vertex<C,E,V>* vertex = this->tree.underlying_tree.get_vertex(vertex_id);
+        {
+            std::shared_lock<std::shared_mutex> lock(this->mutex);
+            C* root;
+            if (this->tree.find_shallow_root(vertex, &root)) {
+                return root;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(this->mutex);
+        return this->tree.find_root_splaying(vertex);
+    }
+
+    bool same_tree(int u, int v) {
+        if (u == v) {
+            return true;
+        }
+        {
+            std::shared_lock<std::shared_mutex> lock(this->mutex);
+            C* root_u;
+            C* root_v;
+            if (this->tree.find_shallow_root(this->tree.underlying_tree.get_vertex(u), &root_u) &&
+                this->tree.find_shallow_root(this->tree.underlying_tree.get_vertex(v), &root_v)) {
+                return root_u && root_u == root_v;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(this->mutex);
+        return this->tree.connected(u, v);
+    }
+
+    // Runs f(TopTree&) with the lock held exclusively. Exposed vertices must be deexposed
+    // again before f returns.
+    template<class Fn>
+    void write(Fn f) {
+        std::unique_lock<std::shared_mutex> lock(this->mutex);
+        f(this->tree);
+    }
+};
+
+#endif
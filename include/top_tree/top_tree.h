@@ -2,6 +2,7 @@
 #define TOP_TREE 1
 
 #include "underlying_tree.h"
+#include <utility>
 #include <vector>
 
 
@@ -24,6 +25,7 @@ class InternalNode;
 template<class C, class E, class V> class Edge;
 template<class C, class E, class V> class Vertex;
 template<class C, class E, class V> class Tree;
+template<class C, class E, class V> class SharedTopTree;
 
 // DefaultC defined in bottom. Inherits from Node and has no fields.
 // merge and split simply does nothing.
@@ -31,13 +33,24 @@ class DefaultC;
 
 template<class C = DefaultC, class E = None, class V = None>
 class TopTree {
-    int num_exposed = 0;
+    friend class SharedTopTree<C,E,V>;
     Tree<C,E,V> underlying_tree;
+    std::vector<C*> root_path_buffer;
+    // Leaves deeper than this are splayed by connected, see find_root_splaying.
+    int splay_depth = 0;
 
     C* find_consuming_node(Vertex<C,E,V>*);
     void delete_all_ancestors(C*);
     C* expose_internal(Vertex<C,E,V>*);
     C* deexpose_internal(Vertex<C,E,V>*);
+    C* find_tree_root(Vertex<C,E,V>*, int* depth = nullptr);
+    C* find_root_splaying(Vertex<C,E,V>*);
+    bool find_shallow_root(Vertex<C,E,V>*, C**);
+
+    std::vector<std::pair<int,int>> steiner_paths;
+    void set_marked(Vertex<C,E,V>*, bool);
+    Vertex<C,E,V>* get_boundary_vertex(C*, int);
+    Vertex<C,E,V>* find_first_marked(C*, bool);
     std::tuple<C*,Edge<C,E,V>*> link_internal(Vertex<C,E,V>*, Vertex<C,E,V>*, E);
     std::tuple<C*, C*> cut_internal(Edge<C,E,V>*);
 
@@ -59,8 +72,52 @@ class TopTree {
 
     C* get_adjacent_leaf_node(int);
     C* get_adjacent_leaf_node(int, int);
-
+    template<class Fn> void for_each_incident_edge(int, Fn);
+
+    // Read only: these follow parent pointers up from the leaf of the first edge of the
+    // vertex, without rotations or user hooks, so any number of threads can run them while
+    // no thread changes the tree. They take O(depth) time, and nothing bounds the depth
+    // unless something splays, see connected and SharedTopTree. find_root is nullptr for
+    // a vertex without edges.
+    C* find_root(int vertex);
+    bool same_tree(int u, int v);
+
+    // Compares the roots above the two vertices, amortized O(log n). Works while vertices
+    // are exposed. A walk from a leaf deeper than splay_depth semi-splays it, and every
+    // rotation of that splay runs the user split and merge, so such a query pays the hook
+    // cost of about one expose. Only walks from shallow leaves are free of hooks.
     bool connected(int v1, int v2);
+
+    // Calls f with the root of each of a set of edge-disjoint paths, which together form
+    // the smallest subtree spanning the terminals, at most one path per terminal after the
+    // first. Returns false, without calling f, if the terminals are not all connected. The
+    // tree of the terminals must have no exposed vertices.
+    template<class Fn> bool expose_set(const std::vector<int>& terminals, Fn f);
+
+    // Keeps one or two vertices exposed while it lives, so that queries and aggregate
+    // updates on the same path share a single expose. retarget only deexposes and exposes
+    // the vertices that differ from the current pair. The trees of the session cannot be
+    // linked or cut while it is open, other trees can, and can have sessions of their own.
+    class ExposeSession {
+        TopTree<C,E,V>* tree;
+        int vertices[2];
+        C* roots[2];
+
+        void release(int);
+        static C* find_root(C*);
+
+        public:
+        ExposeSession(TopTree<C,E,V>&, int u, int v);
+        ExposeSession(TopTree<C,E,V>&, int vertex);
+        ExposeSession(const ExposeSession&) = delete;
+        ExposeSession& operator=(const ExposeSession&) = delete;
+        ~ExposeSession();
+
+        C* retarget(int u, int v);
+        C* retarget(int vertex);
+        C* get_root();
+        bool connected();
+    };
     
     TopTree(int size);
     TopTree() {};
@@ -81,6 +138,8 @@ class Node {
     InternalNode<C,E,V>* parent;
     int num_boundary_vertices;
     bool flipped = false;
+    // Marked vertices whose first edge is in the cluster, see TopTree::expose_set.
+    int num_marked = 0;
  
     //These must be implemented by the user!
     virtual void merge(C*, C*) = 0;
@@ -7,6 +7,11 @@
 template<class C, class E, class V>
 TopTree<C,E,V>::TopTree(int size) {
     this->underlying_tree = Tree<C,E,V>(size);
+    // Twice the depth of a balanced tree, plus slack. Leaves of random forests stay below it.
+    for (int rest = size; rest > 0; rest >>= 1) {
+        this->splay_depth += 2;
+    }
+    this->splay_depth += 8;
 }
 template<class C, class E, class V>
 TopTree<C,E,V>::~TopTree() {
@@ -73,21 +78,37 @@ C* TopTree<C,E,V>::find_consuming_node(Vertex<C,E,V>* vertex) {
 
 template<class C, class E, class V>
 C* TopTree<C,E,V>::expose(int vertex1_id, int vertex2_id) {
-    assert(this->num_exposed == 0);
-    this->num_exposed += 2;
-    Vertex<C,E,V>* vertex1 = this->underlying_tree.get_vertex(vertex1_id);
-    Vertex<C,E,V>* vertex2 = this->underlying_tree.get_vertex(vertex2_id);
-    expose_internal(vertex1);
-    return expose_internal(vertex2);
+    this->expose(vertex1_id);
+    return this->expose(vertex2_id);
 }
+// Each tree of the forest can have up to two exposed vertices, independently of the others.
 template<class C, class E, class V>
 C* TopTree<C,E,V>::expose(int vertex_id) {
-    assert(this->num_exposed < 2);
-    this->num_exposed += 1;
     Vertex<C,E,V>* vertex = this->underlying_tree.get_vertex(vertex_id);
+    assert(!vertex->is_exposed());
     return expose_internal(vertex);
 }
 
+// The root above the leaf of the first edge of the vertex, or nullptr if it has no edges.
+// Optionally counts the number of parent pointers followed in depth.
+template<class C, class E, class V>
+C* TopTree<C,E,V>::find_tree_root(Vertex<C,E,V>* vertex, int* depth) {
+    Edge<C,E,V>* edge = vertex->get_first_edge();
+    if (!edge) {
+        return nullptr;
+    }
+    C* root = edge->node;
+    int steps = 0;
+    while (root->get_parent()) {
+        root = root->get_parent();
+        steps++;
+    }
+    if (depth) {
+        *depth = steps;
+    }
+    return root;
+}
+
 template<class C, class E, class V>
 C* TopTree<C,E,V>::expose_internal(Vertex<C,E,V>* vertex) {
     C* node = this->find_consuming_node(vertex);
@@ -96,6 +117,9 @@ C* TopTree<C,E,V>::expose_internal(Vertex<C,E,V>* vertex) {
         return nullptr;
     }
     while (node->is_path()) {
+        // The root has the exposed vertices of the tree as its boundary vertices, a root
+        // path cluster means that two are exposed already.
+        assert(node->get_parent());
         //Is this legal? 
         InternalNode<C,E,V>* node_int = (InternalNode<C,E,V>*) node;
         InternalNode<C,E,V>* parent = (InternalNode<C,E,V>*) (node->get_parent());
@@ -111,6 +135,8 @@ C* TopTree<C,E,V>::expose_internal(Vertex<C,E,V>* vertex) {
     //Assert that the depth is at most 1, by lemma 4.3
     assert(!node->get_parent() || (node->get_parent() && !node->get_parent()->get_parent())); 
     InternalNode<C,E,V>* parent = node->get_parent();
+    // Checks the exposed vertices of the tree from its root, now at hand in O(1) time.
+    assert((parent ? parent : node)->num_boundary_vertices < 2);
     
     if (parent) {
         parent->split_internal();
@@ -134,7 +160,8 @@ C* TopTree<C,E,V>::deexpose_internal(Vertex<C,E,V>* vertex) {
     C* root = nullptr;
     C* node = this->find_consuming_node(vertex); 
 
-    static std::vector<C*> root_path;
+    // Scratch buffer owned by this tree, so that separate trees can be used from separate threads.
+    std::vector<C*>& root_path = this->root_path_buffer;
     root_path.clear();
     while (node) {
         root_path.push_back(node);
@@ -155,25 +182,19 @@ C* TopTree<C,E,V>::deexpose_internal(Vertex<C,E,V>* vertex) {
 
 template<class C, class E, class V>
 C* TopTree<C,E,V>::deexpose(int vertex1_id, int vertex2_id) { 
-    assert(this->num_exposed == 2);
-    this->num_exposed -= 2;
-    Vertex<C,E,V>* vertex1 = this->underlying_tree.get_vertex(vertex1_id);
-    Vertex<C,E,V>* vertex2 = this->underlying_tree.get_vertex(vertex2_id);
-    deexpose_internal(vertex1);
-    return deexpose_internal(vertex2);
+    this->deexpose(vertex1_id);
+    return this->deexpose(vertex2_id);
 }
 
 template<class C, class E, class V>
 C* TopTree<C,E,V>::deexpose(int vertex_id) { 
-    assert(this->num_exposed >= 1);
-    this->num_exposed -= 1;
     Vertex<C,E,V>* vertex = this->underlying_tree.get_vertex(vertex_id);
+    assert(vertex->is_exposed());
     return deexpose_internal(vertex);
 }
 
 template<class C, class E, class V>
 C* TopTree<C,E,V>::link(int u_id, int v_id, E data) {
-    assert(this->num_exposed == 0);
     Vertex<C,E,V>* u = this->underlying_tree.get_vertex(u_id); 
     Vertex<C,E,V>* v = this->underlying_tree.get_vertex(v_id); 
     return std::get<0>(link_internal(u, v, data));
@@ -181,7 +202,6 @@ C* TopTree<C,E,V>::link(int u_id, int v_id, E data) {
 
 template<class C, class E, class V>
 Edge<C,E,V>* TopTree<C,E,V>::link_ptr(int u_id, int v_id, E data) {
-    assert(this->num_exposed == 0);
     Vertex<C,E,V>* u = this->underlying_tree.get_vertex(u_id); 
     Vertex<C,E,V>* v = this->underlying_tree.get_vertex(v_id); 
     return std::get<1>(link_internal(u, v, data));
@@ -189,7 +209,6 @@ Edge<C,E,V>* TopTree<C,E,V>::link_ptr(int u_id, int v_id, E data) {
 
 template<class C, class E, class V>
 C* TopTree<C,E,V>::link_leaf(int u_id, int v_id, E data) {
-    assert(this->num_exposed == 0);
     Vertex<C,E,V>* u = this->underlying_tree.get_vertex(u_id); 
     Vertex<C,E,V>* v = this->underlying_tree.get_vertex(v_id); 
     Edge<C,E,V>* new_edge = std::get<1>(link_internal(u, v, data));
@@ -204,6 +223,8 @@ C* TopTree<C,E,V>::link_leaf(int u_id, int v_id, E data) {
 template<class C, class E, class V>
 std::tuple<C*,Edge<C,E,V>*> TopTree<C,E,V>::link_internal(Vertex<C,E,V>* u, Vertex<C,E,V>* v, E data) {
     C* Tu = expose_internal(u);
+    // Tu is the root of u's tree, and u must be its only exposed vertex.
+    assert(!Tu || Tu->get_num_boundary_vertices() == 1);
     C* Tv = expose_internal(v);
 
     //Tu now has constant depth 
@@ -214,6 +235,8 @@ std::tuple<C*,Edge<C,E,V>*> TopTree<C,E,V>::link_internal(Vertex<C,E,V>* u, Vert
         depth++;
     }
     assert(depth <= 5);
+    // Tv is the root of v's tree, and has u exposed too if it is Tu's tree.
+    assert(!Tv || Tv->get_num_boundary_vertices() == 1 + (root_u == Tv));
 
     //Compare the root of Tu, Tv if u and v already connected, return null.
     if (root_u == Tv && root_u && Tv) {
@@ -249,6 +272,8 @@ std::tuple<C*,Edge<C,E,V>*> TopTree<C,E,V>::link_internal(Vertex<C,E,V>* u, Vert
 template<class C, class E, class V>
 void TopTree<C,E,V>::delete_all_ancestors(C* node) {
     C* parent = node->get_parent();
+    // Cut needs the tree to have no exposed vertices, which are the boundary vertices of the root.
+    assert(parent || node->get_num_boundary_vertices() == 0);
     if (parent) {
         C* sibling = node->get_sibling();
         delete_all_ancestors(parent);
@@ -262,20 +287,17 @@ void TopTree<C,E,V>::delete_all_ancestors(C* node) {
 
 template<class C, class E, class V>
 std::tuple<C*, C*> TopTree<C,E,V>::cut(int u_id, int v_id) {
-    assert(this->num_exposed == 0);
     Edge<C,E,V>* e = this->underlying_tree.find_edge(u_id, v_id);
     return this->cut_internal(e);
 }
 
 template<class C, class E, class V>
 std::tuple<C*, C*> TopTree<C,E,V>::cut_ptr(Edge<C,E,V>* edge) {
-    assert(this->num_exposed == 0);
     return this->cut_internal(edge);
 }
 
 template<class C, class E, class V>
 std::tuple<C*, C*> TopTree<C,E,V>::cut_leaf(C* node) {
-    assert(this->num_exposed == 0);
     LeafNode<C,E,V>* leaf_node = (LeafNode<C,E,V> *) node;
     return this->cut_internal(leaf_node->edge);
 }
@@ -321,21 +343,276 @@ C* TopTree<C,E,V>::get_adjacent_leaf_node(int vertex_id) {
     return this->get_adjacent_leaf_node(vertex_id, 0);
 }
 
+//Calls f(neighbour id, E*) for every edge at the vertex. Takes O(degree) time
 template<class C, class E, class V>
-bool TopTree<C,E,V>::connected(int u, int v) {
-    assert(this->num_exposed == 0);
-    C* Tu = expose(u);
-    C* Tv = expose(v);
+template<class Fn>
+void TopTree<C,E,V>::for_each_incident_edge(int vertex_id, Fn f) {
+    Vertex<C,E,V>* vertex = this->underlying_tree.get_vertex(vertex_id);
+    for (Edge<C,E,V>* current = vertex->get_first_edge(); current; ) {
+        int is_right_vertex = current->is_right_vertex(vertex);
+        f(current->get_endpoint(!is_right_vertex)->get_id(), current->get_data());
+        current = current->get_next(is_right_vertex);
+    }
+}
 
-    C* root_u = Tu;
+template<class C, class E, class V>
+C* TopTree<C,E,V>::find_root(int vertex_id) {
+    return this->find_tree_root(this->underlying_tree.get_vertex(vertex_id));
+}
+
+template<class C, class E, class V>
+bool TopTree<C,E,V>::same_tree(int u, int v) {
+    if (u == v) {
+        return true;
+    }
+    C* root_u = this->find_root(u);
+    return root_u && root_u == this->find_root(v);
+}
+
+// Walks up from the leaf of the vertex, and semi-splays the leaf, as find_consuming_node
+// does before exposing, if it is deeper than splay_depth. The walk is then paid for by
+// the splay, otherwise it is O(log n) by the choice of splay_depth, so this takes
+// amortized O(log n) time. The rotations never move the root, so exposed vertices are
+// unaffected. They do run the user split and merge, as every rotation must push pending
+// tags down before it regroups the children. A deep leaf therefore costs about one expose
+// in hooks, O(log n) split and merge calls. After the splay its walks are short again, so
+// this is rare: 38 of 1.9M walks in connected_bench on a random forest with n=100k.
+template<class C, class E, class V>
+C* TopTree<C,E,V>::find_root_splaying(Vertex<C,E,V>* vertex) {
     int depth = 0;
-    while (root_u && root_u->get_parent()) {
-        root_u = root_u->get_parent();
-        depth++;
+    C* root = this->find_tree_root(vertex, &depth);
+    if (depth > this->splay_depth) {
+        vertex->get_first_edge()->node->semi_splay();
     }
-    assert(depth <= 5);
-    bool result = root_u && Tv && root_u == Tv;
-    deexpose(u);
-    deexpose(v);
-    return result;
-}
\ No newline at end of file
+    return root;
+}
+
+// Read only, gives up after splay_depth parent pointers.
+template<class C, class E, class V>
+bool TopTree<C,E,V>::find_shallow_root(Vertex<C,E,V>* vertex, C** root) {
+    Edge<C,E,V>* edge = vertex->get_first_edge();
+    if (!edge) {
+        *root = nullptr;
+        return true;
+    }
+    C* node = edge->node;
+    for (int steps = 0; node->get_parent(); steps++) {
+        if (steps == this->splay_depth) {
+            return false;
+        }
+        node = node->get_parent();
+    }
+    *root = node;
+    return true;
+}
+
+template<class C, class E, class V>
+bool TopTree<C,E,V>::connected(int u, int v) {
+    if (u == v) {
+        return true;
+    }
+    C* root_u = this->find_root_splaying(this->underlying_tree.get_vertex(u));
+    return root_u && root_u == this->find_root_splaying(this->underlying_tree.get_vertex(v));
+}
+
+// A mark is counted in the leaf of the first edge of the vertex and in its ancestors.
+template<class C, class E, class V>
+void TopTree<C,E,V>::set_marked(Vertex<C,E,V>* vertex, bool marked) {
+    if (vertex->marked == marked) {
+        return;
+    }
+    vertex->marked = marked;
+    Edge<C,E,V>* edge = vertex->get_first_edge();
+    for (C* node = edge ? edge->node : nullptr; node; node = node->get_parent()) {
+        node->num_marked += marked ? 1 : -1;
+    }
+}
+
+// The boundary vertices of a cluster are ordered from left to right. The vertex shared by
+// the children of an internal node is the last boundary vertex of its left child and the
+// first of its right child, the others are boundary vertices of the node if the child is
+// a path. Takes O(depth) time.
+template<class C, class E, class V>
+Vertex<C,E,V>* TopTree<C,E,V>::get_boundary_vertex(C* node, int index) {
+    node->push_flip();
+    if (!node->get_child(0)) {
+        LeafNode<C,E,V>* leaf_node = (LeafNode<C,E,V>*) node;
+        if (!leaf_node->has_left_boundary()) {
+            index++;
+        }
+        return leaf_node->get_endpoint(index);
+    }
+    InternalNode<C,E,V>* node_int = (InternalNode<C,E,V>*) node;
+    if (node_int->children[0]->is_path()) {
+        if (index == 0) {
+            return this->get_boundary_vertex(node_int->children[0], 0);
+        }
+        index--;
+    }
+    if (node_int->has_middle_boundary()) {
+        if (index == 0) {
+            return this->get_boundary_vertex(node_int->children[1], 0);
+        }
+        index--;
+    }
+    assert(index == 0 && node_int->children[1]->is_path());
+    return this->get_boundary_vertex(node_int->children[1], 1);
+}
+
+// The first vertex on the path of a path cluster, from its left or right boundary vertex,
+// that has a marked vertex counted in the cluster hanging off the path from it. Marks are
+// counted in the cluster of their first edge, so a marked path vertex may be counted in a
+// leaf of the path, and the child towards the start is searched first whenever it has any.
+template<class C, class E, class V>
+Vertex<C,E,V>* TopTree<C,E,V>::find_first_marked(C* node, bool from_right) {
+    assert(node->is_path() && node->num_marked > 0);
+    node->push_flip();
+    if (!node->get_child(0)) {
+        LeafNode<C,E,V>* leaf_node = (LeafNode<C,E,V>*) node;
+        Vertex<C,E,V>* start = leaf_node->get_endpoint(from_right);
+        if (start->marked && start->get_first_edge() == leaf_node->edge) {
+            return start;
+        }
+        return leaf_node->get_endpoint(!from_right);
+    }
+    InternalNode<C,E,V>* node_int = (InternalNode<C,E,V>*) node;
+    C* near = node_int->children[from_right];
+    C* far = node_int->children[!from_right];
+    // The near child holds the start of the path, or hangs off it at the middle vertex.
+    if (near->num_marked > 0) {
+        return near->is_path() ? this->find_first_marked(near, from_right) : this->get_boundary_vertex(node_int->children[1], 0);
+    }
+    return far->is_path() ? this->find_first_marked(far, from_right) : this->get_boundary_vertex(node_int->children[1], 0);
+}
+
+// Exposing a terminal together with the first, the path between them meets the subtree
+// spanning the terminals so far in the first vertex with a terminal hanging off it.
+template<class C, class E, class V>
+template<class Fn>
+bool TopTree<C,E,V>::expose_set(const std::vector<int>& terminals, Fn f) {
+    this->steiner_paths.clear();
+    bool connected = true;
+    if (!terminals.empty()) {
+        int first = terminals[0];
+        this->set_marked(this->underlying_tree.get_vertex(first), true);
+        for (int terminal : terminals) {
+            Vertex<C,E,V>* vertex = this->underlying_tree.get_vertex(terminal);
+            if (vertex->marked) {
+                continue;
+            }
+            C* root = this->expose(terminal, first);
+            if (!root || root->get_num_boundary_vertices() != 2) {
+                this->deexpose(terminal, first);
+                connected = false;
+                break;
+            }
+            bool from_right = this->get_boundary_vertex(root, 0) != vertex;
+            int meet = this->find_first_marked(root, from_right)->get_id();
+            this->deexpose(terminal, first);
+            // A terminal on the subtree so far adds no path.
+            if (meet != terminal) {
+                this->steiner_paths.push_back(std::make_pair(terminal, meet));
+            }
+            this->set_marked(vertex, true);
+        }
+        for (int terminal : terminals) {
+            this->set_marked(this->underlying_tree.get_vertex(terminal), false);
+        }
+    }
+    if (!connected) {
+        return false;
+    }
+    for (std::pair<int,int>& path : this->steiner_paths) {
+        f(this->expose(path.first, path.second));
+        this->deexpose(path.first, path.second);
+    }
+    return true;
+}
+
+template<class C, class E, class V>
+TopTree<C,E,V>::ExposeSession::ExposeSession(TopTree<C,E,V>& tree, int u, int v) : tree(&tree), vertices{-1, -1}, roots{nullptr, nullptr} {
+    this->retarget(u, v);
+}
+
+template<class C, class E, class V>
+TopTree<C,E,V>::ExposeSession::ExposeSession(TopTree<C,E,V>& tree, int vertex) : ExposeSession(tree, vertex, vertex) {}
+
+template<class C, class E, class V>
+TopTree<C,E,V>::ExposeSession::~ExposeSession() {
+    this->release(this->vertices[0]);
+    if (this->vertices[1] != this->vertices[0]) {
+        this->release(this->vertices[1]);
+    }
+}
+
+template<class C, class E, class V>
+void TopTree<C,E,V>::ExposeSession::release(int vertex_id) {
+    this->tree->deexpose(vertex_id);
+}
+
+// Exposing or deexposing another vertex of the same tree restructures it, but does not
+// delete nodes, so a former root is still below the current one.
+template<class C, class E, class V>
+C* TopTree<C,E,V>::ExposeSession::find_root(C* node) {
+    while (node && node->get_parent()) {
+        node = node->get_parent();
+    }
+    return node;
+}
+
+// Returns the root of v's tree, as expose(u, v) does.
+template<class C, class E, class V>
+C* TopTree<C,E,V>::ExposeSession::retarget(int u, int v) {
+    for (int i = 0; i < 2; i++) {
+        int vertex_id = this->vertices[i];
+        if (vertex_id == -1 || (i == 1 && vertex_id == this->vertices[0])) {
+            continue;
+        }
+        if (vertex_id != u && vertex_id != v) {
+            this->release(vertex_id);
+        }
+    }
+    int targets[2] = {u, v};
+    C* new_roots[2];
+    bool exposed[2] = {false, false};
+    for (int i = 0; i < 2; i++) {
+        int vertex_id = targets[i];
+        if (i == 1 && vertex_id == u) {
+            new_roots[1] = new_roots[0];
+            exposed[1] = exposed[0];
+        } else if (vertex_id == this->vertices[0]) {
+            new_roots[i] = this->roots[0];
+        } else if (vertex_id == this->vertices[1]) {
+            new_roots[i] = this->roots[1];
+        } else {
+            new_roots[i] = this->tree->expose(vertex_id);
+            exposed[i] = true;
+        }
+    }
+    // expose_internal returns the root. Its tree holds both vertices exactly if it has two
+    // boundary vertices, otherwise a kept vertex's root is found from its former root.
+    int last = exposed[1] ? 1 : 0;
+    if (exposed[last] && u != v && new_roots[last] && new_roots[last]->get_num_boundary_vertices() == 2) {
+        new_roots[!last] = new_roots[last];
+    }
+    for (int i = 0; i < 2; i++) {
+        this->vertices[i] = targets[i];
+        this->roots[i] = exposed[i] ? new_roots[i] : find_root(new_roots[i]);
+    }
+    return this->roots[1];
+}
+
+template<class C, class E, class V>
+C* TopTree<C,E,V>::ExposeSession::retarget(int vertex_id) {
+    return this->retarget(vertex_id, vertex_id);
+}
+
+template<class C, class E, class V>
+C* TopTree<C,E,V>::ExposeSession::get_root() {
+    return this->roots[1];
+}
+
+template<class C, class E, class V>
+bool TopTree<C,E,V>::ExposeSession::connected() {
+    return this->vertices[0] == this->vertices[1] || (this->roots[0] && this->roots[0] == this->roots[1]);
+}
@@ -64,6 +64,7 @@ class Vertex : VHolder<V> {
 
     int id;
     bool exposed;
+    bool marked;
     Edge<C, E, V>* first_edge;
     
     
@@ -73,6 +74,7 @@ class Vertex : VHolder<V> {
     void set_first_edge(Edge<C,E,V>*);
     bool has_at_most_one_incident_edge();
     bool is_exposed();
+    bool is_marked();
     int get_id();
 
     V* get_data();
@@ -8,6 +8,7 @@ Vertex<C,E,V>::Vertex(int id) {
     this->id = id;
     this->first_edge = nullptr;
     this->exposed = false;
+    this->marked = false;
 }
 template<class C, class E, class V>
 Edge<C,E,V>* Vertex<C,E,V>::get_first_edge() {
@@ -35,6 +36,11 @@ bool Vertex<C,E,V>::is_exposed() {
     return this->exposed;
 };
 
+template<class C, class E, class V>
+bool Vertex<C,E,V>::is_marked() {
+    return this->marked;
+};
+
 template<class C, class E, class V>
 V* Vertex<C,E,V>::get_data() {
     return &(this->vertex_data);
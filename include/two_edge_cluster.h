@@ -9,20 +9,50 @@
 #include <vector>
 #include <memory>
 #include <bitset>
+#include <climits>
+#include <cstdint>
 
 #include "top_tree.h"
+#include "part_size.h"
+
+// Bit i is set if level i is present.
+using LevelMask = std::uint64_t;
+
+// Aggregates TwoEdgeCluster maintains besides the cover levels, picked at compile time.
+// Cover levels alone answer two_edge_connected and find_bridge while edges are only
+// inserted. Removing edges searches for replacements and needs both find size and
+// find first label. Bridge counts answer count_bridges. Find lightest label needs find
+// first label, and all labels to be WeightedLabels.
+template<bool FindSize, bool FindFirstLabel, bool CountBridges, bool FindLightestLabel = false>
+struct TwoEdgeFeatures {
+    static constexpr bool find_size = FindSize;
+    static constexpr bool find_first_label = FindFirstLabel;
+    static constexpr bool count_bridges = CountBridges;
+    static constexpr bool find_lightest_label = FindLightestLabel;
+    static_assert(FindFirstLabel || !FindLightestLabel, "find lightest label keeps its vertices with find first label");
+};
+using AllFeatures = TwoEdgeFeatures<true, true, true>;
+using BridgesOnly = TwoEdgeFeatures<false, false, false>;
+using BridgeCounts = TwoEdgeFeatures<false, false, true>;
 
-struct VertexLabel;
-struct TwoEdgeConnectivty;
-struct TwoEdgeCluster;
+template<int L, class P = DensePartSize<L>, class F = AllFeatures> struct VertexLabel;
+template<int L, class P, class F> class TwoEdgeConnectivity;
+template<int L, class P = DensePartSize<L>, class F = AllFeatures> class TwoEdgeCluster;
 
+template<int L, class P, class F>
 struct VertexLabel {
-    std::vector<std::vector<std::shared_ptr<EdgeData>>> labels;
-    TwoEdgeCluster* leaf_node = nullptr; 
+    // With find lightest label each list is a binary heap by weight, lightest first.
+    std::vector<std::shared_ptr<EdgeData>> labels[L];
+    LevelMask levels = 0; // Levels with a non-empty labels list
+    TwoEdgeCluster<L,P,F>* leaf_node = nullptr; 
+
+    int lightest(int level) {
+        return this->labels[level].empty() ? INT_MAX : static_cast<WeightedLabel*>(this->labels[level].front().get())->weight;
+    };
 
     void print() {
-        for (int i = 0; i < labels.size(); i++) {
-            //if (i == 0) continue;
+        for (LevelMask bits = levels; bits; bits &= bits - 1) {
+            int i = __builtin_ctzll(bits);
             for (int j = 0; j < labels[i].size(); j++) {
                 std::cout << "(" << labels[i][j]->endpoints[0] << "," << labels[i][j]->endpoints[1] << "; " <<  labels[i][j]->level << ")";
             }
@@ -30,24 +60,36 @@ struct VertexLabel {
     }
     VertexLabel() {
     };
+};
 
-    VertexLabel(int lmax) {
-        this->labels = std::vector<std::vector<std::shared_ptr<EdgeData>>>(lmax);
-        for (int i = 0; i < this->labels.size(); i++) {
-            this->labels[i] = std::vector<std::shared_ptr<EdgeData>>();
-        }
-    };
-
+// Per level the weight of the lightest label, INT_MAX for none. The counterpart of incident
+// and part_incident, only stored with find lightest label.
+template<int L, bool Enabled>
+struct LightestLabels {};
 
+template<int L>
+struct LightestLabels<L, true> {
+    int incident[L];
+    int part_incident[2][L + 2][L];
 };
 
-class TwoEdgeCluster : public Node<TwoEdgeCluster,TreeEdgeData,None> {
-    friend class TwoEdgeConnectivity;
+// L is the level bound l_max. It is a compile-time constant so that the find size and
+// find first label loops have fixed trip counts, a tree on n vertices needs L >= floor(log2(n)).
+// P stores the part_size matrices, DensePartSize<L> or SparsePartSize<L>, see part_size.h.
+// F is a TwoEdgeFeatures. Disabled aggregates are neither computed nor readable, their
+// storage stays; with SparsePartSize an unused part_size costs a few bytes.
+template<int L, class P, class F>
+class TwoEdgeCluster : public Node<TwoEdgeCluster<L,P,F>,TreeEdgeData,None> {
+    static_assert(L + 2 < 64, "levels are stored in 64 bit masks");
+    template<int, class, class> friend class TwoEdgeConnectivity;
 
     int last_uncover = -1;
+    // Set by split and destroy. The aggregates are stale until the next merge or create,
+    // which overwrite all of them, so split does not zero anything.
+    bool dirty = false;
 
     //Cover level
-    inline static int l_max; //floor(log (tree_size))
+    static constexpr int l_max = L; //at least floor(log (tree_size))
     int cover_level = -1;
     int cover_plus = -1;
     int cover_minus = -1;
@@ -56,39 +98,48 @@ class TwoEdgeCluster : public Node<TwoEdgeCluster,TreeEdgeData,None> {
     TreeEdgeData* min_path_edge = nullptr;
     TreeEdgeData* min_global_edge = nullptr;
 
+    // Bridge counts. path_edges[i + 1] counts the path edges with cover level i, the
+    // bridges on the path are path_edges[0]. global_bridges counts the other bridges.
+    int path_edges[L + 2];
+    int global_bridges = 0;
+
     void cover_level_cover(int);
     void cover_level_uncover(int);
+    void bridge_count_cover(int);
+    void bridge_count_uncover(int);
+    void merge_bridge_count(TwoEdgeCluster*, TwoEdgeCluster*);
+    void create_bridge_count(TreeEdgeData*);
     
 
     void merge_cover(TwoEdgeCluster*, TwoEdgeCluster*);
     void create_cover(TreeEdgeData*, None*, None*);
-    void split_cover(TwoEdgeCluster*, TwoEdgeCluster*);
     void destroy_cover(TreeEdgeData*, None*, None*);
 
     //Find Size
-    std::vector<int> size;
-    std::vector<std::vector<int>> part_size[2]; // could be binary tree
+    // part_size[s] is an (l_max + 2) x l_max matrix, row i holds cover level i - 1.
+    // swap_data only toggles part_swapped, use get_part_size to get the matrix of a side.
+    int size[L];
+    P part_size[2];
+    bool part_swapped = false;
+
+    P& get_part_size(int);
 
     void find_size_cover(int);
     void find_size_uncover(int);
 
-    void compute_part_size(std::vector<std::vector<int>>&, std::vector<std::vector<int>>&, std::vector<std::vector<int>>&, int);
-    void sum_row_range(std::vector<int>&, std::vector<std::vector<int>>&, int, int);
-    void delete_row_range(std::vector<std::vector<int>>&, int, int);
-    void sum_diagonal(std::vector<int>&, std::vector<std::vector<int>>&);
-
     void merge_find_size(TwoEdgeCluster*, TwoEdgeCluster*);
     void create_find_size(TreeEdgeData*, None*, None*);
-    void split_find_size(TwoEdgeCluster*, TwoEdgeCluster*);
     void destroy_find_size(TreeEdgeData*, None*, None*);
     
     
     
     // Find First Label
-    VertexLabel* vertex[2] = {nullptr,nullptr};
+    VertexLabel<L,P,F>* vertex[2] = {nullptr,nullptr};
     int boundary_vertices_id[2] = {-1,-1};
-    long int incident;
-    std::vector<long int> part_incident[2];
+    LevelMask incident;
+    LevelMask part_incident[2][L + 2];
+
+    LevelMask* get_part_incident(int);
 
 
     void find_first_label_cover(int);
@@ -96,28 +147,42 @@ class TwoEdgeCluster : public Node<TwoEdgeCluster,TreeEdgeData,None> {
 
     void merge_find_first_label(TwoEdgeCluster*, TwoEdgeCluster*);
     void create_find_first_label(TreeEdgeData*, None*, None*);
-    void split_find_first_label(TwoEdgeCluster*, TwoEdgeCluster*);
     void destroy_find_first_label(TreeEdgeData*,  None*, None*);
 
+    // Find Lightest Label
+    LightestLabels<L, F::find_lightest_label> lightest;
+
+    int (*get_part_lightest(int))[L];
+
+    void find_lightest_label_cover(int);
+    void find_lightest_label_uncover(int);
+
+    void merge_find_lightest_label(TwoEdgeCluster*, TwoEdgeCluster*);
+    void create_find_lightest_label(TreeEdgeData*, None*, None*);
+    void destroy_find_lightest_label(TreeEdgeData*, None*, None*);
+
 
 
     public:
-    std::tuple<TwoEdgeCluster*,VertexLabel*> find_first_label(int, int , int);
+    std::tuple<TwoEdgeCluster*,VertexLabel<L,P,F>*> find_first_label(int, int , int);
+    VertexLabel<L,P,F>* find_lightest_label(int, int);
+    void find_bridges(bool, int, std::vector<TreeEdgeData*>&);
     TwoEdgeCluster();
     ~TwoEdgeCluster() {
     };
 
-    static void set_l_max(int);
-    static int get_l_max();
+    static constexpr int get_l_max() { return L; };
     int get_cover_level();
 
     void cover(int);
     void uncover(int);
 
-    void assign_vertex(int, VertexLabel*);
+    void assign_vertex(int, VertexLabel<L,P,F>*);
 
     int get_size(int);
-    long int get_incident();
+    LevelMask get_incident();
+    int get_path_bridges();
+    int get_bridges();
 
     void create(TreeEdgeData*, None*, None*);
     void merge(TwoEdgeCluster*, TwoEdgeCluster*);
@@ -132,16 +197,16 @@ class TwoEdgeCluster : public Node<TwoEdgeCluster,TreeEdgeData,None> {
         std::cout << " c:" << this->cover_level << " c-:" << this->cover_minus << " c+:" << this->cover_plus << " "; 
         //std::cout << " f: " << this->is_flipped() << " ";
         std::cout << " [";
-        for (int i = 0; i <this->size.size(); i++) {
+        for (int i = 0; i < l_max; i++) {
             std::cout << this->size[i] << ",";
         }
         std::cout << "] ";
         // for (int i = 0 ; i < 2; i++) {
         //     std::cout << "p" << i << ": ["; 
-        //     for (int j = 0; j < this->part_size[i].size(); j++) {
+        //     for (int j = 0; j < l_max + 2; j++) {
         //         std::cout << "[";
-        //         for(int k = 0; k < this->part_size[i][j].size(); k++) {
-        //             std::cout << this->part_size[i][j][k] << ",";
+        //         for(int k = 0; k < l_max; k++) {
+        //             std::cout << this->get_part_size(i).get(j, k) << ",";
         //         }
         //         std::cout << "],";
         //     }
@@ -160,7 +225,10 @@ class TwoEdgeCluster : public Node<TwoEdgeCluster,TreeEdgeData,None> {
     };
 };
 
-
-
+#include "two_edge_cluster.hpp"
+#include "cover_level.hpp"
+#include "find_size.hpp"
+#include "find_first_label.hpp"
+#include "find_lightest_label.hpp"
 
 #endif
\ No newline at end of file
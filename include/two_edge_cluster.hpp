@@ -0,0 +1,141 @@
+#include "two_edge_cluster.h"
+
+
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::cover(int level) {
+    if constexpr (F::find_size) {
+        this->find_size_cover(level);
+    }
+    if constexpr (F::find_first_label) {
+        this->find_first_label_cover(level);
+    }
+    if constexpr (F::find_lightest_label) {
+        this->find_lightest_label_cover(level);
+    }
+    if constexpr (F::count_bridges) {
+        this->bridge_count_cover(level);
+    }
+    this->cover_level_cover(level);
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::uncover(int level) {
+    if constexpr (F::find_size) {
+        this->find_size_uncover(level);
+    }
+    if constexpr (F::find_first_label) {
+        this->find_first_label_uncover(level);
+    }
+    if constexpr (F::find_lightest_label) {
+        this->find_lightest_label_uncover(level);
+    }
+    if constexpr (F::count_bridges) {
+        this->bridge_count_uncover(level);
+    }
+    this->cover_level_uncover(level);
+}
+
+template<int L, class P, class F>
+TwoEdgeCluster<L,P,F>::TwoEdgeCluster() {
+    int lmax = TwoEdgeCluster::get_l_max();
+
+    std::fill_n(this->size, lmax, 0);
+
+    this->incident = 0;
+    std::fill_n(this->part_incident[0], lmax + 2, 0);
+    std::fill_n(this->part_incident[1], lmax + 2, 0);
+
+    if constexpr (F::find_lightest_label) {
+        std::fill_n(this->lightest.incident, L, INT_MAX);
+        std::fill_n(&this->lightest.part_incident[0][0][0], 2 * (L + 2) * L, INT_MAX);
+    }
+}
+
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::swap_data() {
+    // Swapping dense matrices would copy them, so only the side mapping is swapped.
+    this->part_swapped = !this->part_swapped;
+    std::swap(this->vertex[0],this->vertex[1]);
+    std::swap(this->boundary_vertices_id[0],this->boundary_vertices_id[1]);
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::assign_vertex(int vertex, VertexLabel<L,P,F>* label) {
+    this->push_flip();
+    int is_right_endpoint = this->get_endpoint_id(1) == vertex; 
+    this->vertex[is_right_endpoint] = label;     
+}
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::create(TreeEdgeData* edge_data, None* left, None* right) {
+    create_cover(edge_data, left, right);
+    if constexpr (F::find_size) {
+        create_find_size(edge_data, left, right);
+    }
+    if constexpr (F::find_first_label) {
+        create_find_first_label(edge_data, left, right);
+    }
+    if constexpr (F::find_lightest_label) {
+        create_find_lightest_label(edge_data, left, right);
+    }
+    if constexpr (F::count_bridges) {
+        create_bridge_count(edge_data);
+    }
+    this->dirty = false;
+};
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::merge(TwoEdgeCluster* left, TwoEdgeCluster* right) {
+    merge_cover(left, right);
+    if constexpr (F::find_size) {
+        merge_find_size(left, right);
+    }
+    if constexpr (F::find_first_label) {
+        merge_find_first_label(left ,right);
+    }
+    if constexpr (F::find_lightest_label) {
+        merge_find_lightest_label(left, right);
+    }
+    if constexpr (F::count_bridges) {
+        merge_bridge_count(left, right);
+    }
+    this->dirty = false;
+};
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::split(TwoEdgeCluster* left, TwoEdgeCluster* right) {
+    this->dirty = true;
+    // Only path clusters carry tags. An uncover(-1) or cover(-1) is a no-op, so a split
+    // without a pending tag does not touch the children.
+    if (this->is_path()) {
+        TwoEdgeCluster* children[2] = {left, right};
+        for (TwoEdgeCluster* child : children) {
+            if (!child->is_path()) {
+                continue;
+            }
+            if (this->cover_minus != -1) {
+                child->uncover(this->cover_minus);
+            }
+            if (this->cover_plus != -1) {
+                child->cover(this->cover_plus);
+            }
+        }
+    }
+    this->cover_plus = -1;
+    this->cover_minus = -1;
+};
+
+template<int L, class P, class F>
+void TwoEdgeCluster<L,P,F>::destroy(TreeEdgeData* edge_data, None* left, None* right) {
+    destroy_cover(edge_data, left, right);
+    if constexpr (F::find_size) {
+        destroy_find_size(edge_data,left,right);
+    }
+    if constexpr (F::find_first_label) {
+        destroy_find_first_label(edge_data,left,right);
+    }
+    if constexpr (F::find_lightest_label) {
+        destroy_find_lightest_label(edge_data, left, right);
+    }
+    this->dirty = true;
+}
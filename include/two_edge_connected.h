@@ -1,67 +1,196 @@
+#ifndef TWO_EDGE_CONNECTED
+#define TWO_EDGE_CONNECTED
+
 #include "edge.h"
 #include "two_edge_cluster.h"
+#include "small_component.h"
 
+#include <array>
 #include <vector>
+#include <unordered_set>
+#include <climits>
 #include <cmath>
+#include <cassert>
 
 using CoverLevel = int;
 
+// A change of the bridge tree, whose nodes are the 2-edge-connected components and whose
+// edges are the bridges. 'endpoints' is the bridge.
+struct BridgeDelta {
+    enum Kind {
+        Linked, // New edge between two trees, a new bridge
+        Cut,    // A bridge was removed
+        Merged, // A bridge got covered, its two components are one now
+        Split   // An edge became a bridge, splitting its component in two
+    };
+    Kind kind;
+    int endpoints[2];
+};
+
+struct BridgeTree {
+    std::vector<int> component; // Per vertex the smallest vertex of its 2-edge-connected component
+    std::vector<std::array<int,2>> bridges;
+};
+
+// L is the level bound of the clusters, see TwoEdgeCluster. It must be at least
+// floor(log2(size)), with_two_edge_connectivity picks a fitting instantiation at runtime.
+// P is the part_size representation of the clusters, see part_size.h. F selects the
+// maintained aggregates, see TwoEdgeFeatures. With BridgesOnly edges can only be inserted.
+//
+// With a small_component_limit, components of at most that many vertices (up to 64) are
+// kept as SmallComponents outside the top tree. They are moved into the top tree when an
+// insert makes them larger, or when expose, find_bridge or a leveled insert touches them,
+// and stay there afterwards.
+template<int L, class P> class DynamicMSF;
+
+template<int L = 32, class P = DensePartSize<L>, class F = AllFeatures>
 class TwoEdgeConnectivity {
-    TopTree<TwoEdgeCluster,TreeEdgeData,None> top_tree;
-    std::vector<VertexLabel*> vertex_labels;
+    template<int, class> friend class DynamicMSF;
+    TopTree<TwoEdgeCluster<L,P,F>,TreeEdgeData,None> top_tree;
+    using ExposeSession = typename TopTree<TwoEdgeCluster<L,P,F>,TreeEdgeData,None>::ExposeSession;
+    std::vector<VertexLabel<L,P,F>*> vertex_labels;
+    int num_vertices = 0;
 
-    int size();
-    std::shared_ptr<EdgeData> swap(std::shared_ptr<EdgeData>);
+    int size() { return this->num_vertices; };
+    std::shared_ptr<EdgeData> swap(std::shared_ptr<EdgeData>, int);
     std::shared_ptr<EdgeData> find_replacement(int,int,int);
     std::shared_ptr<EdgeData> recover_phase(int, int, int, int);
     std::shared_ptr<EdgeData> find_first_label(int, int, int);
+    VertexLabel<L,P,F>* find_first_vertex_label(int, int, int);
     void recover(int, int, int);
     void add_label(int, std::shared_ptr<EdgeData>);
     void remove_labels(std::shared_ptr<EdgeData>);
-    void reassign_vertices(TwoEdgeCluster*);
+    void move_label(std::shared_ptr<EdgeData>, int);
+    void sift_label(int, int, int);
+    std::shared_ptr<EdgeData> find_lightest_label(int, int);
+    // Scratch space of recover_phase
+    std::vector<std::shared_ptr<EdgeData>> label_batch;
+    std::vector<int> relabelled;
+    void reassign_vertices(TwoEdgeCluster<L,P,F>*);
     int cover_level(int, int);
 
+    static constexpr int Isolated = -1;
+    static constexpr int InTopTree = -2;
+    int small_component_limit = 0;
+    // Per vertex the index into small_components, Isolated or InTopTree. Empty without a limit.
+    std::vector<int> small_component;
+    std::vector<std::uint8_t> small_index; // Local index in its SmallComponent
+    std::vector<SmallComponent> small_components;
+    std::vector<int> free_small_components;
+
+    bool in_top_tree(int);
+    void promote(int);
+    int allocate_small_component();
+    void free_small_component(int);
+    void store_small_component(int, SmallComponent);
+    bool insert_small(std::shared_ptr<EdgeData>);
+    void remove_small(std::shared_ptr<EdgeData>);
+    void insert_top_tree(std::shared_ptr<EdgeData>);
+    TwoEdgeCluster<L,P,F>* link_tree_edge(std::shared_ptr<EdgeData>);
+
+    bool tracking_bridges = false;
+    std::vector<BridgeDelta> bridge_deltas;
+    void record_insert(int, int);
+    void record_bridges(BridgeDelta::Kind, const std::vector<TreeEdgeData*>&);
+    void remove_edge(std::shared_ptr<EdgeData>);
+
     public: 
     int two_size();
     int find_size(int, int, int);
     std::shared_ptr<EdgeData> insert(int, int);
+    void insert(std::shared_ptr<EdgeData>);
     std::shared_ptr<EdgeData> insert(int, int, int); // TODO: SKAL Måske væk
     void remove(std::shared_ptr<EdgeData>); //delete is keyword.
     bool two_edge_connected(int,int);
+    bool connected(int,int);
     TreeEdgeData* find_bridge(int);
     TreeEdgeData* find_bridge(int, int);
+    // All bridges on the path between two vertices, or in the component of a vertex, in no
+    // particular order. O((k + 1) log n) for k bridges.
+    std::vector<TreeEdgeData*> find_bridges(int, int);
+    std::vector<TreeEdgeData*> find_bridges(int);
+    // Number of bridges on the path between two vertices, in the component of a vertex, or
+    // in the smallest subtree spanning a set of vertices. Needs F::count_bridges.
+    int count_bridges(int, int);
+    int count_bridges(int);
+    int count_bridges(const std::vector<int>&);
+    // For every vertex the smallest vertex of its 2-edge-connected component.
+    // O(n + (k + 1) log n) for k bridges in total.
+    std::vector<int> two_edge_component_ids();
+    // The current bridge tree, O(n + (k + 1) log n).
+    BridgeTree bridge_tree();
+    // While tracking, each insert and remove appends the bridge tree changes it causes, found
+    // from the tree edges whose cover level leaves or drops to -1. This costs an extra
+    // bridge enumeration on the updated path, and moves touched small components into the
+    // top tree. take_bridge_deltas returns the changes since the last call.
+    void track_bridges(bool);
+    std::vector<BridgeDelta> take_bridge_deltas();
     void cover(int, int, int); // TODO: move to private and remove test
     void uncover(int, int, int); // TODO: move to private and remove test
     
-    TwoEdgeCluster* expose(int u) {
+    TwoEdgeCluster<L,P,F>* expose(int u) {
+        this->promote(u);
         return this->top_tree.expose(u);
     };
-    TwoEdgeCluster* expose(int u, int v) {
+    TwoEdgeCluster<L,P,F>* expose(int u, int v) {
+        this->promote(u);
+        this->promote(v);
         return this->top_tree.expose(u, v);
     };
-    TwoEdgeCluster* deexpose(int u) {
+    TwoEdgeCluster<L,P,F>* deexpose(int u) {
         return this->top_tree.deexpose(u);
     };
-    TwoEdgeCluster* deexpose(int u, int v) {
+    TwoEdgeCluster<L,P,F>* deexpose(int u, int v) {
         return this->top_tree.deexpose(u, v);
     };
 
     TwoEdgeConnectivity();
-    TwoEdgeConnectivity(int size) {
-        TwoEdgeCluster::set_l_max((int) floor(log2(size)));
-        this->top_tree = TopTree<TwoEdgeCluster,TreeEdgeData,None>(size);
-        this->vertex_labels = std::vector<VertexLabel*>(size);
-        for (int i = 0; i < size; i++) {
-            vertex_labels[i] = new VertexLabel(TwoEdgeCluster::get_l_max()); // TODO, make sure lmax is accessed similarly everywhere.
+    TwoEdgeConnectivity(int size, int small_component_limit = 0) {
+        assert(size <= 1 || (int) floor(log2(size)) <= L);
+        assert(0 <= small_component_limit && small_component_limit <= SmallComponent::max_size);
+        this->top_tree = TopTree<TwoEdgeCluster<L,P,F>,TreeEdgeData,None>(size);
+        this->num_vertices = size;
+        this->small_component_limit = small_component_limit;
+        if (small_component_limit > 0) {
+            this->small_component = std::vector<int>(size, Isolated);
+            this->small_index = std::vector<std::uint8_t>(size);
+        }
+        if constexpr (F::find_first_label) {
+            this->vertex_labels = std::vector<VertexLabel<L,P,F>*>(size);
+            for (int i = 0; i < size; i++) {
+                vertex_labels[i] = new VertexLabel<L,P,F>();
+            }
         }
     };
     ~TwoEdgeConnectivity() {
         // TODO: reinsert
         // delete top_tree;
         for (int j = 0; j < this->vertex_labels.size(); j++) {
-            VertexLabel* vertex_label = this->vertex_labels[j];
+            VertexLabel<L,P,F>* vertex_label = this->vertex_labels[j];
             delete vertex_label;
         }
     };
 };
 
+template<int L, template<int> class P, class F, class Fn>
+auto with_two_edge_connectivity_bound(int size, int lmax, Fn& f) {
+    if constexpr (L < 32) {
+        if (lmax > L) {
+            return with_two_edge_connectivity_bound<L + 4, P, F>(size, lmax, f);
+        }
+    }
+    TwoEdgeConnectivity<L,P<L>,F> graph = TwoEdgeConnectivity<L,P<L>,F>(size);
+    return f(graph);
+}
+
+// Calls f with a TwoEdgeConnectivity<L,P<L>,F> on 'size' vertices, where L is the smallest
+// multiple of 4 that fits. Cluster work is O(L^2), so L is kept close to floor(log2(size)).
+template<template<int> class P = DensePartSize, class F = AllFeatures, class Fn>
+auto with_two_edge_connectivity(int size, Fn f) {
+    int lmax = size <= 1 ? 0 : (int) floor(log2(size));
+    return with_two_edge_connectivity_bound<4, P, F>(size, lmax, f);
+}
+
+#include "two_edge_connected.hpp"
+
+#endif
@@ -0,0 +1,848 @@
+#include "two_edge_connected.h"
+#include <algorithm>
+#include <tuple>
+
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::cover(int u, int v, int level) {
+    this->promote(u);
+    this->promote(v);
+    TwoEdgeCluster<L,P,F> *root = this->top_tree.expose(u, v);
+    root->cover(level);
+    this->top_tree.deexpose(u, v);
+}
+
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::uncover(int u, int v, int level) {
+    this->promote(u);
+    this->promote(v);
+    TwoEdgeCluster<L,P,F> *root = this->top_tree.expose(u, v);
+    root->uncover(level);
+    this->top_tree.deexpose(u, v);
+}
+
+template<int L, class P, class F>
+std::shared_ptr<EdgeData> TwoEdgeConnectivity<L,P,F>::insert(int u, int v) {
+    //Try to link u,v in tree
+    if (u == v) {
+        return nullptr;
+    }
+    std::shared_ptr<EdgeData> edge = std::make_shared<EdgeData>(u, v);
+    this->insert(edge);
+    return edge;
+}
+
+// Inserts an edge whose endpoints are set, and fills in the rest of it.
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::insert(std::shared_ptr<EdgeData> edge) {
+    int u = edge->endpoints[0];
+    int v = edge->endpoints[1];
+    assert(u != v);
+    if (this->tracking_bridges) {
+        this->record_insert(u, v);
+    }
+    if (!this->in_top_tree(u) && !this->in_top_tree(v) && this->insert_small(edge)) {
+        return;
+    }
+    this->promote(u);
+    this->promote(v);
+    this->insert_top_tree(edge);
+}
+
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::insert_top_tree(std::shared_ptr<EdgeData> edge) {
+    int u = edge->endpoints[0];
+    int v = edge->endpoints[1];
+
+    if (this->link_tree_edge(edge)) {
+        return;
+    }
+    // Level 0 non tree edge
+    edge->edge_type = NonTreeEdge;
+    edge->level = 0;
+    if constexpr (F::find_first_label) {
+        this->add_label(u, edge);
+        this->add_label(v, edge);
+    }
+    this->cover(u, v, 0);
+}
+
+// Links edge into the spanning forest as an uncovered tree edge, if its endpoints are not
+// connected, and gives its endpoints the new leaf if they had none. Returns the leaf or nullptr.
+template<int L, class P, class F>
+TwoEdgeCluster<L,P,F>* TwoEdgeConnectivity<L,P,F>::link_tree_edge(std::shared_ptr<EdgeData> edge) {
+    int u = edge->endpoints[0];
+    int v = edge->endpoints[1];
+    TwoEdgeCluster<L,P,F>* result = this->top_tree.link_leaf(u, v, TreeEdgeData(u, v, -1)); //TODO level = lmax?
+    if (!result) {
+        return nullptr;
+    }
+    edge->edge_type = TreeEdge;
+    edge->level = -1;
+    edge->extra_data.leaf_node = result;
+    if constexpr (F::find_first_label) {
+        //If successfull, try to assign vertex endpoints to new leaf
+        result->full_splay();
+        if (!vertex_labels[u]->leaf_node) {
+            result->assign_vertex(u, vertex_labels[u]);
+            vertex_labels[u]->leaf_node = result;
+        }
+        if (!vertex_labels[v]->leaf_node) {
+            result->assign_vertex(v, vertex_labels[v]);
+            vertex_labels[v]->leaf_node = result;
+        }
+        result->recompute_root_path();
+    }
+    return result;
+}
+
+template<int L, class P, class F>
+std::shared_ptr<EdgeData> TwoEdgeConnectivity<L,P,F>::insert(int u, int v, int level) {
+    if (this->tracking_bridges) {
+        this->record_insert(u, v);
+    }
+    this->promote(u);
+    this->promote(v);
+    TwoEdgeCluster<L,P,F>* result = this->top_tree.link_leaf(u, v, TreeEdgeData(u, v, -1)); //TODO level = lmax?
+    if (result) {
+        return std::make_shared<EdgeData>(u, v, -1, result); // Constructs tree edge, with result leaf node
+    }
+    std::shared_ptr<EdgeData> edge = std::make_shared<EdgeData>(NonTreeEdge, u, v, level); // construct level non tree edge
+    if constexpr (F::find_first_label) {
+        this->add_label(u, edge);
+        this->add_label(v, edge);
+    }
+    this->cover(u, v, level);
+    return edge;
+}
+
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::add_label(int vertex, std::shared_ptr<EdgeData> edge) {
+    VertexLabel<L,P,F>* vertex_label = this->vertex_labels[vertex];    
+    int index = vertex_label->labels[edge->level].size();
+
+    if (edge->endpoints[0] == vertex) {
+        edge->extra_data.index[0] = index;
+    } else {
+        edge->extra_data.index[1] = index;
+    }
+    vertex_label->labels[edge->level].push_back(edge);
+    vertex_label->levels |= LevelMask(1) << edge->level;
+    if constexpr (F::find_lightest_label) {
+        this->sift_label(vertex, edge->level, index);
+    }
+    
+    if (vertex_label->leaf_node) {
+        vertex_label->leaf_node->full_splay(); //depth <= 5
+        vertex_label->leaf_node->recompute_root_path(); //takes O(depth) = O(1) time
+    }
+}
+
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::remove_labels(std::shared_ptr<EdgeData> edge) {
+    int level = edge->level;
+
+    for (int i = 0; i < 2; i++) {
+        int ep = edge->endpoints[i];
+        int ep_idx = edge->extra_data.index[i];
+
+        VertexLabel<L,P,F>* ep_label = this->vertex_labels[ep];
+        
+        std::shared_ptr<EdgeData> last_label = ep_label->labels[level].back();
+        int ep_is_right_new = last_label->endpoints[1] == ep;
+
+        ep_label->labels[level][ep_idx] = last_label;
+        ep_label->labels[level][ep_idx]->extra_data.index[ep_is_right_new] = ep_idx;
+        ep_label->labels[level].pop_back();
+        if (ep_label->labels[level].empty()) {
+            ep_label->levels &= ~(LevelMask(1) << level);
+        }
+        if constexpr (F::find_lightest_label) {
+            if (ep_idx < (int) ep_label->labels[level].size()) {
+                this->sift_label(ep, level, ep_idx);
+            }
+        }
+
+        if (ep_label->leaf_node) {
+            ep_label->leaf_node->full_splay();
+            ep_label->leaf_node->recompute_root_path();
+        }
+    }
+}   
+
+// Moves a non-tree edge to another level in the labels of both endpoints. Unlike
+// add_label and remove_labels the leaves holding the endpoints are not recomputed.
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::move_label(std::shared_ptr<EdgeData> edge, int level) {
+    int old_level = edge->level;
+    for (int i = 0; i < 2; i++) {
+        VertexLabel<L,P,F>* vertex_label = this->vertex_labels[edge->endpoints[i]];
+        std::vector<std::shared_ptr<EdgeData>>& old_labels = vertex_label->labels[old_level];
+        int index = edge->extra_data.index[i];
+        std::shared_ptr<EdgeData> last_label = old_labels.back();
+        old_labels[index] = last_label;
+        last_label->extra_data.index[last_label->endpoints[1] == edge->endpoints[i]] = index;
+        old_labels.pop_back();
+        if (old_labels.empty()) {
+            vertex_label->levels &= ~(LevelMask(1) << old_level);
+        }
+
+        edge->extra_data.index[i] = vertex_label->labels[level].size();
+        vertex_label->labels[level].push_back(edge);
+        vertex_label->levels |= LevelMask(1) << level;
+        if constexpr (F::find_lightest_label) {
+            if (index < (int) old_labels.size()) {
+                this->sift_label(edge->endpoints[i], old_level, index);
+            }
+            this->sift_label(edge->endpoints[i], level, edge->extra_data.index[i]);
+        }
+    }
+    edge->level = level;
+}
+
+// Restores the heap order of the labels of vertex on level after the label at index was
+// placed, moving it up or down. Labels are WeightedLabels with find lightest label.
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::sift_label(int vertex, int level, int index) {
+    std::vector<std::shared_ptr<EdgeData>>& heap = this->vertex_labels[vertex]->labels[level];
+    auto weight = [&](int i) { return static_cast<WeightedLabel*>(heap[i].get())->weight; };
+    auto place = [&](int i) { heap[i]->extra_data.index[heap[i]->endpoints[1] == vertex] = i; };
+    while (index > 0 && weight(index) < weight((index - 1) / 2)) {
+        std::swap(heap[index], heap[(index - 1) / 2]);
+        place(index);
+        index = (index - 1) / 2;
+    }
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= (int) heap.size()) {
+            break;
+        }
+        if (child + 1 < (int) heap.size() && weight(child + 1) < weight(child)) {
+            child++;
+        }
+        if (weight(index) <= weight(child)) {
+            break;
+        }
+        std::swap(heap[index], heap[child]);
+        place(index);
+        index = child;
+    }
+    place(index);
+}
+
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::reassign_vertices(TwoEdgeCluster<L,P,F>* leaf_node) {
+    leaf_node->full_splay();
+    // A pending flip has swapped vertex but not the endpoints yet.
+    leaf_node->push_flip();
+    VertexLabel<L,P,F>* old_labels[2] = {leaf_node->vertex[0],leaf_node->vertex[1]};
+    leaf_node->vertex[0] = nullptr;
+    leaf_node->vertex[1] = nullptr;
+    leaf_node->recompute_root_path();
+    for (int i = 0; i < 2; i++) {
+        if (old_labels[i]) {
+            //find new edge
+            int id = leaf_node->get_endpoint_id(i);
+            TwoEdgeCluster<L,P,F>* replacement = this->top_tree.get_adjacent_leaf_node(id);
+            if (replacement == leaf_node) {
+                replacement = this->top_tree.get_adjacent_leaf_node(id, 1);
+                if (!replacement) {
+                    old_labels[i]->leaf_node = nullptr;
+                    continue;
+                }
+            
+            } 
+            
+            replacement->full_splay();
+
+            replacement->assign_vertex(id, old_labels[i]);
+            old_labels[i]->leaf_node = replacement;
+
+            replacement->recompute_root_path();
+        }
+    }
+}
+
+
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::remove(std::shared_ptr<EdgeData> edge) {
+    static_assert(F::find_size && F::find_first_label, "remove needs find size and find first label");
+    if (!this->tracking_bridges) {
+        this->remove_edge(edge);
+        return;
+    }
+    int u = edge->endpoints[0];
+    int v = edge->endpoints[1];
+    // The edge joins u and v, so it is a bridge exactly if they are not 2-edge-connected.
+    // Otherwise the new bridges are those left uncovered on the path between them.
+    bool was_bridge = !this->two_edge_connected(u, v);
+    this->remove_edge(edge);
+    if (was_bridge) {
+        this->bridge_deltas.push_back(BridgeDelta { BridgeDelta::Cut, { u, v } });
+    } else {
+        this->record_bridges(BridgeDelta::Split, this->find_bridges(u, v));
+    }
+}
+
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::remove_edge(std::shared_ptr<EdgeData> edge) {
+    if (edge->edge_type == SmallComponentEdge) {
+        this->remove_small(edge);
+        return;
+    }
+    int u = edge->endpoints[0];
+    int v = edge->endpoints[1];
+
+    int alpha = edge->level;
+
+    int test = false;
+    if (edge->edge_type == TreeEdge) {
+        test = true;
+        int cover_level = this->cover_level(u, v);
+        alpha = cover_level;
+        if (cover_level == -1) {
+            TwoEdgeCluster<L,P,F>* leaf_node = (TwoEdgeCluster<L,P,F>*) edge->extra_data.leaf_node;
+            reassign_vertices(leaf_node);
+            this->top_tree.cut_leaf(leaf_node);
+            return;
+        }
+        edge = this->swap(edge, cover_level);
+    } 
+    this->remove_labels(edge);
+
+    this->uncover(u, v, alpha);
+
+    for (int i = alpha; i >= 0; i--) {
+        this->recover(v, u, i);
+    }
+}
+
+template<int L, class P, class F>
+int TwoEdgeConnectivity<L,P,F>::cover_level(int u, int v) {
+    TwoEdgeCluster<L,P,F>* root = this->top_tree.expose(u, v);
+    int cover_level = root->get_cover_level();
+    this->top_tree.deexpose(u, v);
+    return cover_level;    
+}
+
+template<int L, class P, class F>
+std::shared_ptr<EdgeData> TwoEdgeConnectivity<L,P,F>::swap(std::shared_ptr<EdgeData> tree_edge, int cover_level) {
+    int u = tree_edge->endpoints[0];
+    int v = tree_edge->endpoints[1];
+
+    TwoEdgeCluster<L,P,F>* leaf_node = (TwoEdgeCluster<L,P,F>*) tree_edge->extra_data.leaf_node;
+    reassign_vertices(leaf_node);
+    this->top_tree.cut_leaf(leaf_node);
+
+    std::shared_ptr<EdgeData> non_tree_edge = find_replacement(u, v, cover_level);
+    this->remove_labels(non_tree_edge);
+    this->link_tree_edge(non_tree_edge);
+
+    std::shared_ptr<EdgeData> edge = std::make_shared<EdgeData>(NonTreeEdge, u, v, cover_level);
+    this->add_label(u, edge);
+    this->add_label(v, edge);
+    this->cover(u, v, cover_level);
+    return edge;
+}
+
+template<int L, class P, class F>
+int TwoEdgeConnectivity<L,P,F>::find_size(int u, int v, int cover_level) {
+    this->promote(u);
+    this->promote(v);
+    TwoEdgeCluster<L,P,F>* root = this->top_tree.expose(u);
+    if (u != v) {
+        root = this->top_tree.expose(v);
+    }
+    int size;
+    if (cover_level >= L) {
+        size = INT32_MAX;
+    } else if (root) {
+        size = root->get_size(cover_level);
+    } else {
+        size = 1;
+    }
+    this->top_tree.deexpose(u);
+    if (u != v) {
+        this->top_tree.deexpose(v);
+    }
+    return size;
+}
+
+template<int L, class P, class F>
+std::shared_ptr<EdgeData> TwoEdgeConnectivity<L,P,F>::find_replacement(int u, int v, int cover_level) {
+    int size_u = this->find_size(u, u, cover_level);
+    int size_v = this->find_size(v, v, cover_level);
+
+    if (size_u <= size_v) {
+        return this->recover_phase(u, u, cover_level, size_u);
+    } else {
+        return this->recover_phase(v, v, cover_level, size_v);
+    }
+}
+
+template<int L, class P, class F>
+std::shared_ptr<EdgeData> TwoEdgeConnectivity<L,P,F>::find_first_label(int u, int v, int cover_level) {
+    VertexLabel<L,P,F>* label = this->find_first_vertex_label(u, v, cover_level);
+    return label ? label->labels[cover_level].back() : nullptr;
+}
+
+// A label on cover_level at most as heavy as every label reachable from u over tree edges
+// with cover level at least cover_level, or nullptr if there are none. Needs
+// F::find_lightest_label.
+template<int L, class P, class F>
+std::shared_ptr<EdgeData> TwoEdgeConnectivity<L,P,F>::find_lightest_label(int u, int cover_level) {
+    VertexLabel<L,P,F>* label;
+
+    TwoEdgeCluster<L,P,F>* root = this->top_tree.expose(u);
+    if (!root) {
+        label = vertex_labels[u];
+        if (label->labels[cover_level].empty()) {
+            label = nullptr;
+        }
+    } else {
+        root->push_flip();
+        label = root->find_lightest_label(u, cover_level);
+    }
+
+    this->top_tree.deexpose(u);
+    return label ? label->labels[cover_level].front() : nullptr;
+}
+
+// A vertex with labels on cover_level, reachable from the path between u and v over
+// tree edges with cover level at least cover_level, or nullptr.
+template<int L, class P, class F>
+VertexLabel<L,P,F>* TwoEdgeConnectivity<L,P,F>::find_first_vertex_label(int u, int v, int cover_level) {
+    VertexLabel<L,P,F>* label;
+
+    TwoEdgeCluster<L,P,F>* root = this->top_tree.expose(u);
+    if (u != v) {
+        root = this->top_tree.expose(v);
+    }
+    if (!root) { // if no root, no tree edges. Look for label in vertex only.
+        label = vertex_labels[u];
+        if (label->labels[cover_level].empty()) {
+            label = nullptr;
+        }
+    } else {
+        root->push_flip();
+        // No splay here, the caller exposes the endpoints of the label next.
+        label = std::get<1>(root->find_first_label(u,v,cover_level));
+    }
+
+    this->top_tree.deexpose(u);
+    if (u != v) {
+        this->top_tree.deexpose(v);
+    }
+    return label;
+}
+
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::recover(int u, int v, int cover_level) {
+    int size = this->find_size(u,v,cover_level) / 2;
+    this->recover_phase(u, v, cover_level, size);
+    this->recover_phase(v, u, cover_level, size);
+
+}
+
+// Works through the labels on cover_level found from the path between u and v, a vertex
+// at a time. Each label either covers its path one level up, if the tree it joins there
+// has at most 'size' vertices, or ends the phase. A label whose endpoints are not
+// connected ends it too and is returned. Exposing the endpoints answers the connectivity,
+// the size and the cover, and moving the session to the next label of the vertex only
+// re-exposes the other endpoint. The leaves of the relabelled endpoints are recomputed
+// once per vertex after the session is closed, labels do not affect any of those.
+template<int L, class P, class F>
+std::shared_ptr<EdgeData> TwoEdgeConnectivity<L,P,F>::recover_phase(int u, int v, int cover_level, int size) {
+    std::shared_ptr<EdgeData> result = nullptr;
+    bool done = false;
+    while (!done) {
+        // u and v are exposed for the search only and not held across batches: a tree has
+        // at most two exposed vertices, and the session below needs both for the endpoints
+        // of each label, which are in the tree of u and v while the label is connected.
+        VertexLabel<L,P,F>* label = this->find_first_vertex_label(u, v, cover_level);
+        if (!label) {
+            break;
+        }
+        this->label_batch = label->labels[cover_level];
+        this->relabelled.clear();
+        {
+            // The labels of the batch share an endpoint, which stays exposed throughout.
+            std::shared_ptr<EdgeData>& first = this->label_batch.front();
+            ExposeSession session(this->top_tree, first->endpoints[0], first->endpoints[1]);
+            for (std::shared_ptr<EdgeData>& edge : this->label_batch) {
+                int q = edge->endpoints[0];
+                int r = edge->endpoints[1];
+                TwoEdgeCluster<L,P,F>* root = session.retarget(q, r);
+                if (!session.connected()) {
+                    result = edge;
+                    done = true;
+                    break;
+                }
+                if (cover_level + 1 < L && root->get_size(cover_level + 1) <= size) {
+                    root->cover(cover_level + 1);
+                    this->move_label(edge, cover_level + 1);
+                    this->relabelled.push_back(q);
+                    this->relabelled.push_back(r);
+                } else {
+                    root->cover(cover_level);
+                    done = true;
+                    break;
+                }
+            }
+        }
+        std::sort(this->relabelled.begin(), this->relabelled.end());
+        this->relabelled.erase(std::unique(this->relabelled.begin(), this->relabelled.end()), this->relabelled.end());
+        for (int vertex : this->relabelled) {
+            VertexLabel<L,P,F>* vertex_label = this->vertex_labels[vertex];
+            if (vertex_label->leaf_node) {
+                vertex_label->leaf_node->full_splay();
+                vertex_label->leaf_node->recompute_root_path();
+            }
+        }
+    }
+    return result;
+}
+
+template<int L, class P, class F>
+bool TwoEdgeConnectivity<L,P,F>::two_edge_connected(int u, int v) {
+    if (u == v) {
+        return true;
+    }
+    if (!this->in_top_tree(u) || !this->in_top_tree(v)) {
+        int component = this->small_component[u];
+        if (this->in_top_tree(u) || this->in_top_tree(v) || component == Isolated || component != this->small_component[v]) {
+            return false;
+        }
+        return this->small_components[component].two_edge_connected(this->small_index[u], this->small_index[v]);
+    }
+    // The connectivity check only splays, only connected pairs are exposed.
+    return this->top_tree.connected(u, v) && this->cover_level(u, v) >= 0;
+}
+
+template<int L, class P, class F>
+bool TwoEdgeConnectivity<L,P,F>::connected(int u, int v) {
+    if (u == v) {
+        return true;
+    }
+    if (!this->in_top_tree(u) || !this->in_top_tree(v)) {
+        int component = this->small_component[u];
+        return !this->in_top_tree(u) && !this->in_top_tree(v) && component != Isolated && component == this->small_component[v];
+    }
+    return this->top_tree.connected(u, v);
+}
+
+template<int L, class P, class F>
+TreeEdgeData* TwoEdgeConnectivity<L,P,F>::find_bridge(int u, int v) {
+    this->promote(u);
+    this->promote(v);
+    TwoEdgeCluster<L,P,F>* root = this->top_tree.expose(u,v);
+    TreeEdgeData* bridge;
+    if (root->cover_level == -1) {
+        bridge = root->min_path_edge;
+    } else {
+        bridge = nullptr;
+    }
+    this->top_tree.deexpose(u,v);
+    return bridge;
+}
+template<int L, class P, class F>
+TreeEdgeData* TwoEdgeConnectivity<L,P,F>::find_bridge(int u) {
+    this->promote(u);
+    std::vector<TreeEdgeData*> bridges;
+    TwoEdgeCluster<L,P,F>* root = this->top_tree.expose(u);
+    if (root) {
+        root->find_bridges(false, 1, bridges);
+    }
+    this->top_tree.deexpose(u);
+    return bridges.empty() ? nullptr : bridges[0];
+}
+
+template<int L, class P, class F>
+std::vector<TreeEdgeData*> TwoEdgeConnectivity<L,P,F>::find_bridges(int u, int v) {
+    this->promote(u);
+    this->promote(v);
+    std::vector<TreeEdgeData*> bridges;
+    if (u == v) {
+        return bridges;
+    }
+    ExposeSession session(this->top_tree, u, v);
+    if (session.connected()) {
+        session.get_root()->find_bridges(true, INT_MAX, bridges);
+    }
+    return bridges;
+}
+
+template<int L, class P, class F>
+std::vector<TreeEdgeData*> TwoEdgeConnectivity<L,P,F>::find_bridges(int u) {
+    this->promote(u);
+    std::vector<TreeEdgeData*> bridges;
+    TwoEdgeCluster<L,P,F>* root = this->top_tree.expose(u);
+    if (root) {
+        root->find_bridges(false, INT_MAX, bridges);
+    }
+    this->top_tree.deexpose(u);
+    return bridges;
+}
+
+template<int L, class P, class F>
+int TwoEdgeConnectivity<L,P,F>::count_bridges(int u, int v) {
+    this->promote(u);
+    this->promote(v);
+    if (u == v) {
+        return 0;
+    }
+    ExposeSession session(this->top_tree, u, v);
+    return session.connected() ? session.get_root()->get_path_bridges() : 0;
+}
+
+template<int L, class P, class F>
+int TwoEdgeConnectivity<L,P,F>::count_bridges(int u) {
+    this->promote(u);
+    TwoEdgeCluster<L,P,F>* root = this->top_tree.expose(u);
+    int count = root ? root->get_bridges() : 0;
+    this->top_tree.deexpose(u);
+    return count;
+}
+
+template<int L, class P, class F>
+int TwoEdgeConnectivity<L,P,F>::count_bridges(const std::vector<int>& vertices) {
+    for (int u : vertices) {
+        this->promote(u);
+    }
+    int count = 0;
+    bool connected = this->top_tree.expose_set(vertices, [&](TwoEdgeCluster<L,P,F>* root) {
+        count += root->get_path_bridges();
+    });
+    return connected ? count : 0;
+}
+
+template<int L, class P, class F>
+std::vector<int> TwoEdgeConnectivity<L,P,F>::two_edge_component_ids() {
+    int n = this->size();
+    std::vector<int> ids(n, -1);
+    std::vector<char> explored(n, false); // Bridges of the tree collected
+    std::unordered_set<TreeEdgeData*> bridges;
+    std::vector<int> todo;
+    for (int v = 0; v < n; v++) {
+        if (ids[v] != -1) {
+            continue;
+        }
+        if (!this->in_top_tree(v)) {
+            int id = this->small_component[v];
+            if (id == Isolated) {
+                ids[v] = v;
+                continue;
+            }
+            SmallComponent& component = this->small_components[id];
+            for (std::uint64_t bits = component.two_edge_component_of(this->small_index[v]); bits; bits &= bits - 1) {
+                ids[component.vertices[__builtin_ctzll(bits)]] = v;
+            }
+            continue;
+        }
+        if (!explored[v]) {
+            for (TreeEdgeData* bridge : this->find_bridges(v)) {
+                bridges.insert(bridge);
+            }
+            explored[v] = true;
+            todo.push_back(v);
+            while (!todo.empty()) {
+                int w = todo.back();
+                todo.pop_back();
+                this->top_tree.for_each_incident_edge(w, [&](int neighbour, TreeEdgeData*) {
+                    if (!explored[neighbour]) {
+                        explored[neighbour] = true;
+                        todo.push_back(neighbour);
+                    }
+                });
+            }
+        }
+        // Vertices are visited in increasing order, so v is the smallest of its component.
+        ids[v] = v;
+        todo.push_back(v);
+        while (!todo.empty()) {
+            int w = todo.back();
+            todo.pop_back();
+            this->top_tree.for_each_incident_edge(w, [&](int neighbour, TreeEdgeData* edge) {
+                if (ids[neighbour] == -1 && !bridges.count(edge)) {
+                    ids[neighbour] = v;
+                    todo.push_back(neighbour);
+                }
+            });
+        }
+    }
+    return ids;
+}
+
+template<int L, class P, class F>
+BridgeTree TwoEdgeConnectivity<L,P,F>::bridge_tree() {
+    BridgeTree tree;
+    tree.component = this->two_edge_component_ids();
+    // Edges between different components are exactly the bridges.
+    for (int v = 0; v < this->size(); v++) {
+        if (this->in_top_tree(v)) {
+            this->top_tree.for_each_incident_edge(v, [&](int neighbour, TreeEdgeData*) {
+                if (v < neighbour && tree.component[v] != tree.component[neighbour]) {
+                    tree.bridges.push_back({ v, neighbour });
+                }
+            });
+        }
+    }
+    for (int id = 0; id < this->small_components.size(); id++) {
+        for (std::shared_ptr<EdgeData>& edge : this->small_components[id].edges) {
+            int u = edge->endpoints[0];
+            int v = edge->endpoints[1];
+            if (tree.component[u] != tree.component[v]) {
+                tree.bridges.push_back({ u, v });
+            }
+        }
+    }
+    return tree;
+}
+
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::track_bridges(bool enable) {
+    this->tracking_bridges = enable;
+    if (!enable) {
+        this->bridge_deltas.clear();
+    }
+}
+
+template<int L, class P, class F>
+std::vector<BridgeDelta> TwoEdgeConnectivity<L,P,F>::take_bridge_deltas() {
+    std::vector<BridgeDelta> deltas;
+    std::swap(deltas, this->bridge_deltas);
+    return deltas;
+}
+
+// Called before inserting (u, v): either it links two trees as a new bridge, or it
+// covers the path between them and the bridges there merge their components.
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::record_insert(int u, int v) {
+    this->promote(u);
+    this->promote(v);
+    if (!this->top_tree.connected(u, v)) {
+        this->bridge_deltas.push_back(BridgeDelta { BridgeDelta::Linked, { u, v } });
+        return;
+    }
+    this->record_bridges(BridgeDelta::Merged, this->find_bridges(u, v));
+}
+
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::record_bridges(BridgeDelta::Kind kind, const std::vector<TreeEdgeData*>& bridges) {
+    for (TreeEdgeData* bridge : bridges) {
+        this->bridge_deltas.push_back(BridgeDelta { kind, { bridge->endpoints[0], bridge->endpoints[1] } });
+    }
+}
+
+template<int L, class P, class F>
+bool TwoEdgeConnectivity<L,P,F>::in_top_tree(int vertex) {
+    return this->small_component.empty() || this->small_component[vertex] == InTopTree;
+}
+
+template<int L, class P, class F>
+int TwoEdgeConnectivity<L,P,F>::allocate_small_component() {
+    if (this->free_small_components.empty()) {
+        this->small_components.emplace_back();
+        return this->small_components.size() - 1;
+    }
+    int id = this->free_small_components.back();
+    this->free_small_components.pop_back();
+    return id;
+}
+
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::free_small_component(int id) {
+    this->small_components[id] = SmallComponent();
+    this->free_small_components.push_back(id);
+}
+
+// Puts a component in slot id and points its vertices to it. A single vertex is Isolated instead.
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::store_small_component(int id, SmallComponent component) {
+    if (component.size() == 1) {
+        this->small_component[component.vertices[0]] = Isolated;
+        this->free_small_component(id);
+        return;
+    }
+    for (int i = 0; i < component.size(); i++) {
+        this->small_component[component.vertices[i]] = id;
+        this->small_index[component.vertices[i]] = i;
+    }
+    this->small_components[id] = std::move(component);
+}
+
+// Moves the small component of vertex into the top tree.
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::promote(int vertex) {
+    if (this->in_top_tree(vertex)) {
+        return;
+    }
+    int id = this->small_component[vertex];
+    if (id == Isolated) {
+        this->small_component[vertex] = InTopTree;
+        return;
+    }
+    SmallComponent component = std::move(this->small_components[id]);
+    this->free_small_component(id);
+    for (int w : component.vertices) {
+        this->small_component[w] = InTopTree;
+    }
+    for (std::shared_ptr<EdgeData>& edge : component.edges) {
+        this->insert_top_tree(edge);
+    }
+}
+
+// Adds an edge between two vertices outside the top tree, unless the component would
+// grow past the limit.
+template<int L, class P, class F>
+bool TwoEdgeConnectivity<L,P,F>::insert_small(std::shared_ptr<EdgeData> edge) {
+    int u = edge->endpoints[0];
+    int v = edge->endpoints[1];
+    int component_u = this->small_component[u];
+    int component_v = this->small_component[v];
+    if (component_u != component_v || component_u == Isolated) {
+        int size_u = component_u == Isolated ? 1 : this->small_components[component_u].size();
+        int size_v = component_v == Isolated ? 1 : this->small_components[component_v].size();
+        if (size_u + size_v > this->small_component_limit) {
+            return false;
+        }
+        for (int i = 0; i < 2; i++) {
+            int& id = i == 0 ? component_u : component_v;
+            if (id == Isolated) {
+                int vertex = edge->endpoints[i];
+                id = this->allocate_small_component();
+                this->small_component[vertex] = id;
+                this->small_index[vertex] = this->small_components[id].add_vertex(vertex);
+            }
+        }
+        if (size_u < size_v) {
+            std::swap(component_u, component_v);
+        }
+        SmallComponent& target = this->small_components[component_u];
+        SmallComponent& source = this->small_components[component_v];
+        for (int i = 0; i < source.size(); i++) {
+            this->small_component[source.vertices[i]] = component_u;
+            this->small_index[source.vertices[i]] = target.size() + i;
+        }
+        target.absorb(source);
+        this->free_small_component(component_v);
+    }
+    this->small_components[component_u].add_edge(edge, this->small_index[u], this->small_index[v]);
+    return true;
+}
+
+// Removes an edge of a small component and splits the component if it fell apart.
+template<int L, class P, class F>
+void TwoEdgeConnectivity<L,P,F>::remove_small(std::shared_ptr<EdgeData> edge) {
+    int u = edge->endpoints[0];
+    int v = edge->endpoints[1];
+    int id = this->small_component[u];
+    SmallComponent& component = this->small_components[id];
+    component.remove_edge(edge.get());
+    std::uint64_t reachable = component.reachable(this->small_index[u]);
+    if (reachable & (std::uint64_t(1) << this->small_index[v])) {
+        return;
+    }
+    SmallComponent rest = component.split(reachable);
+    this->store_small_component(id, std::move(component));
+    this->store_small_component(this->allocate_small_component(), std::move(rest));
+}
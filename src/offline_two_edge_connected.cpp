@@ -0,0 +1,291 @@
+#include "offline_two_edge_connected.h"
+
+#include <algorithm>
+#include <cassert>
+
+int OfflineTwoEdgeConnectivity::insert(int u, int v) {
+    assert(0 <= u && u < this->num_vertices && 0 <= v && v < this->num_vertices);
+    this->edges.push_back(Edge { { u, v }, this->num_queries(), -1 });
+    return this->edges.size() - 1;
+}
+
+void OfflineTwoEdgeConnectivity::remove(int edge) {
+    assert(this->edges[edge].end == -1);
+    this->edges[edge].end = this->num_queries();
+}
+
+int OfflineTwoEdgeConnectivity::two_edge_connected(int u, int v) {
+    assert(0 <= u && u < this->num_vertices && 0 <= v && v < this->num_vertices);
+    this->query_endpoints[0].push_back(u);
+    this->query_endpoints[1].push_back(v);
+    return this->num_queries() - 1;
+}
+
+std::vector<bool> OfflineTwoEdgeConnectivity::solve() {
+    int num_queries = this->num_queries();
+    std::vector<bool> answers(num_queries);
+    if (num_queries == 0) {
+        return answers;
+    }
+    std::vector<Edge> live;
+    for (Edge edge : this->edges) {
+        if (edge.end == -1) {
+            edge.end = num_queries;
+        }
+        if (edge.begin < edge.end && edge.endpoints[0] != edge.endpoints[1]) {
+            live.push_back(edge);
+        }
+    }
+    this->mapped_query_endpoints[0] = this->query_endpoints[0];
+    this->mapped_query_endpoints[1] = this->query_endpoints[1];
+    this->solve(0, num_queries, this->num_vertices, live, answers);
+    this->mapped_query_endpoints[0] = std::vector<int>();
+    this->mapped_query_endpoints[1] = std::vector<int>();
+    return answers;
+}
+
+// Answers the queries [lo, hi) on a graph with n vertices, 'edges' are the edges alive
+// during some of these queries.
+void OfflineTwoEdgeConnectivity::solve(int lo, int hi, int n, std::vector<Edge>& edges, std::vector<bool>& answers) {
+    std::vector<Edge> forest;
+    n = this->contract(lo, hi, n, edges, forest);
+    if (hi - lo == 1) {
+        answers[lo] = this->mapped_query_endpoints[0][lo] == this->mapped_query_endpoints[1][lo];
+        return;
+    }
+    int mid = (lo + hi) / 2;
+    int ranges[2][2] = { { lo, mid }, { mid, hi } };
+    for (auto& range : ranges) {
+        std::vector<Edge> child_edges = forest;
+        for (Edge& edge : edges) {
+            bool permanent = edge.begin <= lo && hi <= edge.end;
+            if (!permanent && edge.begin < range[1] && range[0] < edge.end) {
+                child_edges.push_back(edge);
+            }
+        }
+        this->solve(range[0], range[1], n, child_edges, answers);
+    }
+}
+
+// Contracts the edges alive during all of [lo, hi). Vertices touched by the other edges
+// or by the queries in [lo, hi) are relevant. Each 2-edge-connected component of the
+// contracted edges becomes one vertex. In the forest of bridges between them, subtrees
+// without relevant vertices are dropped and irrelevant vertices with two bridges are
+// merged into a neighbour, a chain of bridges breaks exactly when one of its bridges would.
+// Renames the endpoints of the remaining edges and queries, writes the kept bridges to
+// 'forest' and returns the new number of vertices, which is O(number of relevant vertices).
+int OfflineTwoEdgeConnectivity::contract(int lo, int hi, int n, std::vector<Edge>& edges, std::vector<Edge>& forest) {
+    std::vector<char> relevant(n, false);
+    std::vector<int> adjacency_start(n + 1, 0);
+    for (Edge& edge : edges) {
+        bool permanent = edge.begin <= lo && hi <= edge.end;
+        for (int endpoint : edge.endpoints) {
+            if (permanent) {
+                adjacency_start[endpoint + 1]++;
+            } else {
+                relevant[endpoint] = true;
+            }
+        }
+    }
+    for (int q = lo; q < hi; q++) {
+        relevant[this->mapped_query_endpoints[0][q]] = true;
+        relevant[this->mapped_query_endpoints[1][q]] = true;
+    }
+    for (int v = 0; v < n; v++) {
+        adjacency_start[v + 1] += adjacency_start[v];
+    }
+    // (neighbour, edge index) pairs of the contracted edges
+    std::vector<std::pair<int,int>> adjacency(adjacency_start[n]);
+    {
+        std::vector<int> position(adjacency_start.begin(), adjacency_start.end() - 1);
+        for (int i = 0; i < edges.size(); i++) {
+            Edge& edge = edges[i];
+            if (edge.begin <= lo && hi <= edge.end) {
+                adjacency[position[edge.endpoints[0]]++] = { edge.endpoints[1], i };
+                adjacency[position[edge.endpoints[1]]++] = { edge.endpoints[0], i };
+            }
+        }
+    }
+
+    // Bridges by low links. Parallel edges are told apart by index, so only the edge to
+    // the parent itself is skipped.
+    std::vector<char> is_bridge(edges.size(), false);
+    std::vector<int> order(n, -1);
+    std::vector<int> low(n);
+    struct Frame { int vertex; int parent_edge; int position; };
+    std::vector<Frame> stack;
+    int counter = 0;
+    for (int root = 0; root < n; root++) {
+        if (order[root] != -1) {
+            continue;
+        }
+        order[root] = low[root] = counter++;
+        stack.push_back(Frame { root, -1, adjacency_start[root] });
+        while (!stack.empty()) {
+            Frame& frame = stack.back();
+            int v = frame.vertex;
+            if (frame.position < adjacency_start[v + 1]) {
+                auto [w, edge] = adjacency[frame.position++];
+                if (edge == frame.parent_edge) {
+                    continue;
+                }
+                if (order[w] == -1) {
+                    order[w] = low[w] = counter++;
+                    stack.push_back(Frame { w, edge, adjacency_start[w] });
+                } else {
+                    low[v] = std::min(low[v], order[w]);
+                }
+            } else {
+                int parent_edge = frame.parent_edge;
+                stack.pop_back();
+                if (!stack.empty()) {
+                    int parent = stack.back().vertex;
+                    low[parent] = std::min(low[parent], low[v]);
+                    if (low[v] > order[parent]) {
+                        is_bridge[parent_edge] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // 2-edge-connected components, connected by the non-bridge edges
+    std::vector<int> component(n, -1);
+    std::vector<int> todo;
+    int num_components = 0;
+    for (int root = 0; root < n; root++) {
+        if (component[root] != -1) {
+            continue;
+        }
+        component[root] = num_components;
+        todo.push_back(root);
+        while (!todo.empty()) {
+            int v = todo.back();
+            todo.pop_back();
+            for (int i = adjacency_start[v]; i < adjacency_start[v + 1]; i++) {
+                auto [w, edge] = adjacency[i];
+                if (!is_bridge[edge] && component[w] == -1) {
+                    component[w] = num_components;
+                    todo.push_back(w);
+                }
+            }
+        }
+        num_components++;
+    }
+
+    // Forest of bridges over the components
+    std::vector<char> relevant_component(num_components, false);
+    for (int v = 0; v < n; v++) {
+        relevant_component[component[v]] |= relevant[v];
+    }
+    std::vector<int> bridges;
+    std::vector<int> degree(num_components, 0);
+    std::vector<int> forest_start(num_components + 1, 0);
+    for (int i = 0; i < edges.size(); i++) {
+        if (is_bridge[i]) {
+            bridges.push_back(i);
+            forest_start[component[edges[i].endpoints[0]] + 1]++;
+            forest_start[component[edges[i].endpoints[1]] + 1]++;
+        }
+    }
+    for (int c = 0; c < num_components; c++) {
+        degree[c] = forest_start[c + 1];
+        forest_start[c + 1] += forest_start[c];
+    }
+    // (neighbour, bridge index) pairs
+    std::vector<std::pair<int,int>> forest_adjacency(forest_start[num_components]);
+    {
+        std::vector<int> position(forest_start.begin(), forest_start.end() - 1);
+        for (int b = 0; b < bridges.size(); b++) {
+            int a = component[edges[bridges[b]].endpoints[0]];
+            int c = component[edges[bridges[b]].endpoints[1]];
+            forest_adjacency[position[a]++] = { c, b };
+            forest_adjacency[position[c]++] = { a, b };
+        }
+    }
+
+    // Drop irrelevant leaves until every leaf is relevant
+    std::vector<char> alive(num_components, true);
+    std::vector<char> bridge_removed(bridges.size(), false);
+    for (int c = 0; c < num_components; c++) {
+        if (!relevant_component[c] && degree[c] <= 1) {
+            alive[c] = false;
+            todo.push_back(c);
+        }
+    }
+    while (!todo.empty()) {
+        int c = todo.back();
+        todo.pop_back();
+        for (int i = forest_start[c]; i < forest_start[c + 1]; i++) {
+            auto [neighbour, bridge] = forest_adjacency[i];
+            if (bridge_removed[bridge]) {
+                continue;
+            }
+            bridge_removed[bridge] = true;
+            degree[neighbour]--;
+            if (alive[neighbour] && !relevant_component[neighbour] && degree[neighbour] <= 1) {
+                alive[neighbour] = false;
+                todo.push_back(neighbour);
+            }
+        }
+    }
+
+    // Every remaining tree has a relevant vertex. Rooted there, each irrelevant vertex with
+    // two bridges is merged into its parent, which contracts a distinct bridge per vertex.
+    std::vector<int> merged_into(num_components);
+    for (int c = 0; c < num_components; c++) {
+        merged_into[c] = c;
+    }
+    std::vector<char> visited(num_components, false);
+    for (int root = 0; root < num_components; root++) {
+        if (!alive[root] || !relevant_component[root] || visited[root]) {
+            continue;
+        }
+        visited[root] = true;
+        todo.push_back(root);
+        while (!todo.empty()) {
+            int c = todo.back();
+            todo.pop_back();
+            for (int i = forest_start[c]; i < forest_start[c + 1]; i++) {
+                auto [child, bridge] = forest_adjacency[i];
+                if (bridge_removed[bridge] || visited[child]) {
+                    continue;
+                }
+                visited[child] = true;
+                if (!relevant_component[child] && degree[child] == 2) {
+                    merged_into[child] = merged_into[c];
+                    bridge_removed[bridge] = true;
+                }
+                todo.push_back(child);
+            }
+        }
+    }
+
+    std::vector<int> new_id(num_components, -1);
+    int new_n = 0;
+    for (int c = 0; c < num_components; c++) {
+        if (alive[c] && merged_into[c] == c) {
+            new_id[c] = new_n++;
+        }
+    }
+    auto rename = [&](int v) {
+        return new_id[merged_into[component[v]]];
+    };
+    for (int b = 0; b < bridges.size(); b++) {
+        if (!bridge_removed[b]) {
+            Edge& bridge = edges[bridges[b]];
+            forest.push_back(Edge { { rename(bridge.endpoints[0]), rename(bridge.endpoints[1]) }, lo, hi });
+        }
+    }
+    for (Edge& edge : edges) {
+        if (!(edge.begin <= lo && hi <= edge.end)) {
+            edge.endpoints[0] = rename(edge.endpoints[0]);
+            edge.endpoints[1] = rename(edge.endpoints[1]);
+        }
+    }
+    for (int q = lo; q < hi; q++) {
+        this->mapped_query_endpoints[0][q] = rename(this->mapped_query_endpoints[0][q]);
+        this->mapped_query_endpoints[1][q] = rename(this->mapped_query_endpoints[1][q]);
+    }
+    return new_n;
+}
@@ -0,0 +1,171 @@
+#include "small_component.h"
+
+#include <cassert>
+
+static std::uint64_t bit(int i) {
+    return std::uint64_t(1) << i;
+}
+
+// Vertices reachable from 'start' in the graph given by neighbour masks.
+static std::uint64_t search(const std::uint64_t* adjacent, int start) {
+    std::uint64_t reached = bit(start);
+    std::uint64_t frontier = reached;
+    while (frontier) {
+        std::uint64_t next = 0;
+        for (std::uint64_t bits = frontier; bits; bits &= bits - 1) {
+            next |= adjacent[__builtin_ctzll(bits)];
+        }
+        frontier = next & ~reached;
+        reached |= frontier;
+    }
+    return reached;
+}
+
+int SmallComponent::add_vertex(int vertex) {
+    assert(this->size() < max_size);
+    this->vertices.push_back(vertex);
+    this->stale = true;
+    return this->size() - 1;
+}
+
+void SmallComponent::add_edge(std::shared_ptr<EdgeData> edge, int u, int v) {
+    edge->edge_type = SmallComponentEdge;
+    edge->level = -1;
+    edge->extra_data.index[0] = this->edges.size();
+    this->edges.push_back(edge);
+    this->local_endpoints.push_back({ (std::uint8_t) u, (std::uint8_t) v });
+    this->stale = true;
+}
+
+void SmallComponent::remove_edge(EdgeData* edge) {
+    int index = edge->extra_data.index[0];
+    assert(this->edges[index].get() == edge);
+    this->edges[index] = this->edges.back();
+    this->edges[index]->extra_data.index[0] = index;
+    this->local_endpoints[index] = this->local_endpoints.back();
+    this->edges.pop_back();
+    this->local_endpoints.pop_back();
+    this->stale = true;
+}
+
+void SmallComponent::absorb(SmallComponent& other) {
+    assert(this->size() + other.size() <= max_size);
+    int offset = this->size();
+    this->vertices.insert(this->vertices.end(), other.vertices.begin(), other.vertices.end());
+    for (int i = 0; i < other.edges.size(); i++) {
+        this->add_edge(other.edges[i], other.local_endpoints[i][0] + offset, other.local_endpoints[i][1] + offset);
+    }
+    other = SmallComponent();
+}
+
+SmallComponent SmallComponent::split(std::uint64_t keep) {
+    SmallComponent kept;
+    SmallComponent rest;
+    std::uint8_t local[max_size];
+    for (int i = 0; i < this->size(); i++) {
+        SmallComponent& side = keep & bit(i) ? kept : rest;
+        local[i] = side.add_vertex(this->vertices[i]);
+    }
+    for (int i = 0; i < this->edges.size(); i++) {
+        int u = this->local_endpoints[i][0];
+        int v = this->local_endpoints[i][1];
+        assert(!(keep & bit(u)) == !(keep & bit(v)));
+        SmallComponent& side = keep & bit(u) ? kept : rest;
+        side.add_edge(this->edges[i], local[u], local[v]);
+    }
+    *this = std::move(kept);
+    return rest;
+}
+
+// adjacent[i] gets the neighbours of local vertex i, multiple[i] those joined to it by
+// parallel edges.
+void SmallComponent::neighbours(std::uint64_t* adjacent, std::uint64_t* multiple) {
+    for (int i = 0; i < this->size(); i++) {
+        adjacent[i] = 0;
+        multiple[i] = 0;
+    }
+    for (auto [u, v] : this->local_endpoints) {
+        if (adjacent[u] & bit(v)) {
+            multiple[u] |= bit(v);
+            multiple[v] |= bit(u);
+        }
+        adjacent[u] |= bit(v);
+        adjacent[v] |= bit(u);
+    }
+}
+
+std::uint64_t SmallComponent::reachable(int u) {
+    std::uint64_t adjacent[max_size];
+    std::uint64_t multiple[max_size];
+    this->neighbours(adjacent, multiple);
+    return search(adjacent, u);
+}
+
+// Bridges are edges of a spanning tree without a parallel edge, whose removal separates
+// their endpoints. Removing all of them leaves the 2-edge-connected components.
+void SmallComponent::recompute() {
+    int k = this->size();
+    std::uint64_t adjacent[max_size];
+    std::uint64_t multiple[max_size];
+    this->neighbours(adjacent, multiple);
+
+    int parent[max_size];
+    std::uint64_t visited = 0;
+    for (int root = 0; root < k; root++) {
+        if (visited & bit(root)) {
+            continue;
+        }
+        parent[root] = -1;
+        visited |= bit(root);
+        std::uint64_t frontier = bit(root);
+        while (frontier) {
+            std::uint64_t next = 0;
+            for (std::uint64_t bits = frontier; bits; bits &= bits - 1) {
+                int x = __builtin_ctzll(bits);
+                for (std::uint64_t children = adjacent[x] & ~visited & ~next; children; children &= children - 1) {
+                    parent[__builtin_ctzll(children)] = x;
+                }
+                next |= adjacent[x] & ~visited;
+            }
+            visited |= next;
+            frontier = next;
+        }
+    }
+
+    // A bridge stays out of 'adjacent'. No cycle runs through a bridge, so this does not
+    // change the later searches.
+    for (int y = 0; y < k; y++) {
+        int x = parent[y];
+        if (x == -1 || multiple[y] & bit(x)) {
+            continue;
+        }
+        adjacent[x] &= ~bit(y);
+        adjacent[y] &= ~bit(x);
+        if (search(adjacent, y) & bit(x)) {
+            adjacent[x] |= bit(y);
+            adjacent[y] |= bit(x);
+        }
+    }
+
+    this->two_edge_component.assign(k, 0);
+    for (int i = 0; i < k; i++) {
+        if (!this->two_edge_component[i]) {
+            std::uint64_t component = search(adjacent, i);
+            for (std::uint64_t bits = component; bits; bits &= bits - 1) {
+                this->two_edge_component[__builtin_ctzll(bits)] = component;
+            }
+        }
+    }
+    this->stale = false;
+}
+
+bool SmallComponent::two_edge_connected(int u, int v) {
+    return this->two_edge_component_of(u) & bit(v);
+}
+
+std::uint64_t SmallComponent::two_edge_component_of(int u) {
+    if (this->stale) {
+        this->recompute();
+    }
+    return this->two_edge_component[u];
+}
@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include <cassert>
+#include <random>
 #include "two_edge_connected.h"
 
 
@@ -106,4 +107,59 @@ TEST_CASE("FFL: cut", "[find first label]") {
     ffl = std::get<1>(root->find_first_label(6,1,1));  
     REQUIRE((ffl->labels[1][0]->endpoints[0] == 13 && ffl->labels[1][0]->endpoints[1] == 14));
     tree.deexpose(1,6);
-}
\ No newline at end of file
+}
+TEST_CASE("FFL: high levels", "[find first label]") {
+    TwoEdgeConnectivity<32> tree = TwoEdgeConnectivity<32>(8);
+    tree.insert(0,1);
+    tree.insert(1,2);
+    tree.insert(2,3);
+    tree.insert(3,4);
+
+    tree.insert(1,3,31);
+    auto root = tree.expose(0,4);
+    REQUIRE(root->get_incident() == (LevelMask(1) << 31));
+    tree.deexpose(0,4);
+
+    root = tree.expose(0,4);
+    auto ffl = std::get<1>(root->find_first_label(0,4,31));
+    REQUIRE(ffl != nullptr);
+    REQUIRE(ffl->labels[31].size() > 0);
+    REQUIRE(std::get<1>(root->find_first_label(0,4,30)) == nullptr);
+    tree.deexpose(0,4);
+}
+
+TEST_CASE("FFL: descent finds a label iff the level is incident", "[find first label]") {
+    const int N = 60;
+    std::mt19937 rng(5);
+    TwoEdgeConnectivity<8> tree = TwoEdgeConnectivity<8>(N);
+    for (int i = 1; i < N; i++) {
+        tree.insert(i, rng() % i);
+    }
+    for (int i = 0; i < N; i++) {
+        int u = rng() % N;
+        int v = rng() % N;
+        if (u != v) {
+            tree.insert(u, v, rng() % 5);
+        }
+    }
+
+    for (int q = 0; q < 200; q++) {
+        int u = rng() % N;
+        int v = rng() % N;
+        if (u == v) {
+            continue;
+        }
+        auto root = tree.expose(u, v);
+        LevelMask incident = root->get_incident();
+        root->push_flip();
+        for (int level = 0; level < 5; level++) {
+            auto label = std::get<1>(root->find_first_label(u, v, level));
+            REQUIRE((label != nullptr) == get_bit(incident, level));
+            if (label) {
+                REQUIRE(label->labels[level].size() > 0);
+            }
+        }
+        REQUIRE(root->get_incident() == incident);
+        tree.deexpose(u, v);
+    }
+}
@@ -0,0 +1,48 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <utility>
+#include <vector>
+#include "find_size_kernels.h"
+
+using find_size_kernels::Isa;
+
+template<int W>
+void check_width(std::mt19937& rng) {
+    Isa isas[] = { Isa::AVX2, Isa::AVX512 };
+    std::uniform_int_distribution<int> value(-50, 50);
+    std::vector<int> source((W + 2) * W);
+    std::vector<int> target(W);
+    for (int& x : source) x = value(rng);
+    for (int& x : target) x = value(rng);
+
+    std::vector<int> rows_expected = target;
+    std::vector<int> triangle_expected = target;
+    find_size_kernels::sum_rows<W>(Isa::Scalar, rows_expected.data(), source.data() + W, W + 1);
+    find_size_kernels::sum_lower_triangle<W>(Isa::Scalar, triangle_expected.data(), source.data());
+
+    for (Isa isa : isas) {
+        if (!find_size_kernels::supported(isa)) {
+            continue;
+        }
+        std::vector<int> rows = target;
+        std::vector<int> triangle = target;
+        find_size_kernels::sum_rows<W>(isa, rows.data(), source.data() + W, W + 1);
+        find_size_kernels::sum_lower_triangle<W>(isa, triangle.data(), source.data());
+        REQUIRE(rows == rows_expected);
+        REQUIRE(triangle == triangle_expected);
+    }
+    // The default pick is one of them.
+    std::vector<int> rows = target;
+    find_size_kernels::sum_rows<W>(rows.data(), source.data() + W, W + 1);
+    REQUIRE(rows == rows_expected);
+}
+
+template<int... W>
+void check_widths(std::mt19937& rng, std::integer_sequence<int, W...>) {
+    (check_width<W>(rng), ...);
+}
+
+TEST_CASE("Kernels: every isa matches scalar", "[find size kernels]") {
+    std::mt19937 rng(7);
+    check_widths(rng, std::make_integer_sequence<int, 33>());
+}
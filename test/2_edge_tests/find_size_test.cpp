@@ -3,15 +3,18 @@
 
 
 //TODO: Change TreeEdgeData() arguments
-using TwoEdgeTree = TopTree<TwoEdgeCluster,TreeEdgeData,None>;
+template<int L>
+using TwoEdgeTree = TopTree<TwoEdgeCluster<L>,TreeEdgeData,None>;
 
-void cover(TwoEdgeTree *T, int v, int w, int i) {
-    TwoEdgeCluster *root = T->expose(v,w);
+template<int L>
+void cover(TwoEdgeTree<L> *T, int v, int w, int i) {
+    TwoEdgeCluster<L> *root = T->expose(v,w);
     root->cover(i);
     T->deexpose(v,w);
 }
-void uncover(TwoEdgeTree *T, int v, int w, int i) {
-    TwoEdgeCluster *root = T->expose(v,w);
+template<int L>
+void uncover(TwoEdgeTree<L> *T, int v, int w, int i) {
+    TwoEdgeCluster<L> *root = T->expose(v,w);
     root->uncover(i);
     root->print(0, false);
     std::cout << std::endl;
@@ -19,8 +22,7 @@ void uncover(TwoEdgeTree *T, int v, int w, int i) {
 }
 
 TEST_CASE("Simple find size test", "[find size test]")  {
-    TwoEdgeTree T = TwoEdgeTree(10);
-    TwoEdgeCluster::set_l_max(3);
+    TwoEdgeTree<3> T = TwoEdgeTree<3>(10);
 
     T.link(1,2,TreeEdgeData());
     T.link(2,3,TreeEdgeData());
@@ -32,20 +34,19 @@ TEST_CASE("Simple find size test", "[find size test]")  {
     T.link(9,8,TreeEdgeData())->print(0, false);
     std::cout << "\n";
     cover(&T,1,5,0);
-    TwoEdgeCluster *root = T.expose(1, 5);
+    TwoEdgeCluster<3> *root = T.expose(1, 5);
     root->print(0,false);
     REQUIRE(root->get_size(0) == 5);
 
 }
 TEST_CASE("Small find size", "[find size test]")  {
-    TwoEdgeTree T = TwoEdgeTree(8);
-    TwoEdgeCluster::set_l_max(4);
+    TwoEdgeTree<4> T = TwoEdgeTree<4>(8);
     
     T.link(1,2, TreeEdgeData());
     T.link(2,3, TreeEdgeData());
 
     cover(&T,1,3,0);
-    TwoEdgeCluster *root = T.expose(1, 3);
+    TwoEdgeCluster<4> *root = T.expose(1, 3);
     root->print(0,false);
     REQUIRE(root->get_size(0) == 3);
 
@@ -53,9 +54,8 @@ TEST_CASE("Small find size", "[find size test]")  {
 
 
 TEST_CASE("Find size test", "[find size test]")  {
-    TwoEdgeTree T = TwoEdgeTree(12);
-    TwoEdgeCluster::set_l_max(3);
-    TwoEdgeCluster *root;
+    TwoEdgeTree<3> T = TwoEdgeTree<3>(12);
+    TwoEdgeCluster<3> *root;
 
     T.link(0,1, TreeEdgeData());
     T.link(1,2, TreeEdgeData());
@@ -90,9 +90,8 @@ TEST_CASE("Find size test", "[find size test]")  {
 
 
 TEST_CASE("FS: Massive", "[find size test]")  {
-    TwoEdgeTree T = TwoEdgeTree(20);
-    TwoEdgeCluster::set_l_max(4);
-    TwoEdgeCluster *root;
+    TwoEdgeTree<4> T = TwoEdgeTree<4>(20);
+    TwoEdgeCluster<4> *root;
 
     T.link(0,1, TreeEdgeData());
     T.link(1,2, TreeEdgeData());
@@ -131,9 +130,8 @@ TEST_CASE("FS: Massive", "[find size test]")  {
 
 
 TEST_CASE("FS: Uncover", "[find size test]")  {
-    TwoEdgeTree T = TwoEdgeTree(20);
-    TwoEdgeCluster::set_l_max(4);
-    TwoEdgeCluster *root;
+    TwoEdgeTree<4> T = TwoEdgeTree<4>(20);
+    TwoEdgeCluster<4> *root;
 
     T.link(0,1, TreeEdgeData());
     T.link(1,2, TreeEdgeData());
@@ -183,9 +181,8 @@ TEST_CASE("FS: Uncover", "[find size test]")  {
 }
 
 TEST_CASE("FS: Uncover massive", "[find size test]")  {
-    TwoEdgeTree T = TwoEdgeTree(20);
-    TwoEdgeCluster::set_l_max(4);
-    TwoEdgeCluster *root;
+    TwoEdgeTree<4> T = TwoEdgeTree<4>(20);
+    TwoEdgeCluster<4> *root;
 
     T.link(0,1, TreeEdgeData());
     T.link(1,2, TreeEdgeData());
@@ -256,9 +253,8 @@ TEST_CASE("FS: Uncover massive", "[find size test]")  {
 
 TEST_CASE("Small", "[find size test]") {
 
-    TwoEdgeTree T = TwoEdgeTree(7);
-    TwoEdgeCluster::set_l_max(4);
-    TwoEdgeCluster *root;
+    TwoEdgeTree<4> T = TwoEdgeTree<4>(7);
+    TwoEdgeCluster<4> *root;
 
     T.link(0,6, TreeEdgeData());
     T.link(0,1, TreeEdgeData());
@@ -288,9 +284,8 @@ TEST_CASE("Small", "[find size test]") {
 
 
 TEST_CASE("FS: minified massive", "[find size test]")  {
-    TwoEdgeTree T = TwoEdgeTree(8);
-    TwoEdgeCluster::set_l_max(2);
-    TwoEdgeCluster *root;
+    TwoEdgeTree<2> T = TwoEdgeTree<2>(8);
+    TwoEdgeCluster<2> *root;
 
     T.link(0,1, TreeEdgeData());
     T.link(1,2, TreeEdgeData());
@@ -314,9 +309,8 @@ TEST_CASE("FS: minified massive", "[find size test]")  {
 }
 
 TEST_CASE("FS: cut", "[find size test]")  {
-    TwoEdgeTree T = TwoEdgeTree(20);
-    TwoEdgeCluster::set_l_max(4);
-    TwoEdgeCluster *root;
+    TwoEdgeTree<4> T = TwoEdgeTree<4>(20);
+    TwoEdgeCluster<4> *root;
 
     T.link(0,1, TreeEdgeData());
     T.link(1,2, TreeEdgeData());
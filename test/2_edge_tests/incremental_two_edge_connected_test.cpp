@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+#include "incremental_two_edge_connected.h"
+
+TEST_CASE("Incremental: small", "[incremental 2-edge]") {
+    IncrementalTwoEdgeConnectivity tree = IncrementalTwoEdgeConnectivity(8);
+    tree.insert(0,1);
+    tree.insert(1,2);
+    tree.insert(2,3);
+    REQUIRE(!tree.two_edge_connected(0,3));
+    REQUIRE(tree.insert(3,3) == nullptr);
+    auto edge = tree.insert(0,3);
+    REQUIRE(tree.two_edge_connected(0,3));
+    REQUIRE(tree.two_edge_connected(1,2));
+    tree.insert(3,4);
+    tree.insert(5,6);
+    tree.insert(4,6);
+    REQUIRE(!tree.two_edge_connected(3,4));
+    tree.insert(5,2);
+    REQUIRE(tree.two_edge_connected(0,6));
+    REQUIRE(!tree.two_edge_connected(0,7));
+    REQUIRE(!tree.is_materialized());
+
+    tree.remove(edge);
+    REQUIRE(tree.is_materialized());
+    REQUIRE(!tree.two_edge_connected(0,1));
+    REQUIRE(tree.two_edge_connected(2,6));
+    REQUIRE(tree.find_bridge(0,6) != nullptr);
+}
+
+TEST_CASE("Incremental: matches TwoEdgeConnectivity", "[incremental 2-edge]") {
+    const int N = 120;
+    for (int seed = 0; seed < 4; seed++) {
+        std::mt19937 rng(seed);
+        TwoEdgeConnectivity<8> expected = TwoEdgeConnectivity<8>(N);
+        IncrementalTwoEdgeConnectivity<8> tree = IncrementalTwoEdgeConnectivity<8>(N);
+        std::vector<std::shared_ptr<EdgeData>> expected_edges;
+        std::vector<std::shared_ptr<EdgeData>> edges;
+
+        // Sparse enough that many bridges stay.
+        for (int i = 0; i < N + N / 4; i++) {
+            int u = rng() % N;
+            int v = rng() % N;
+            if (u == v) {
+                continue;
+            }
+            expected_edges.push_back(expected.insert(u, v));
+            edges.push_back(tree.insert(u, v));
+            for (int q = 0; q < 5; q++) {
+                int a = rng() % N;
+                int b = rng() % N;
+                REQUIRE(tree.two_edge_connected(a, b) == expected.two_edge_connected(a, b));
+            }
+        }
+        REQUIRE(!tree.is_materialized());
+
+        while (!edges.empty()) {
+            int i = rng() % edges.size();
+            expected.remove(expected_edges[i]);
+            tree.remove(edges[i]);
+            expected_edges.erase(expected_edges.begin() + i);
+            edges.erase(edges.begin() + i);
+            for (int q = 0; q < 5; q++) {
+                int a = rng() % N;
+                int b = rng() % N;
+                REQUIRE(tree.two_edge_connected(a, b) == expected.two_edge_connected(a, b));
+            }
+            if (edges.size() % 10 == 0) {
+                int u = rng() % N;
+                int v = rng() % N;
+                if (u != v) {
+                    expected_edges.push_back(expected.insert(u, v));
+                    edges.push_back(tree.insert(u, v));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+#include "offline_two_edge_connected.h"
+#include "two_edge_connected.h"
+
+TEST_CASE("Offline: small", "[offline 2-edge]") {
+    OfflineTwoEdgeConnectivity solver = OfflineTwoEdgeConnectivity(6);
+    solver.insert(0,1);
+    solver.insert(1,2);
+    int closing = solver.insert(2,0);
+    solver.insert(2,3);
+    solver.two_edge_connected(0,2);
+    solver.two_edge_connected(2,3);
+    solver.insert(3,4);
+    solver.insert(4,2);
+    solver.two_edge_connected(0,4);
+    solver.remove(closing);
+    solver.two_edge_connected(0,4);
+    solver.two_edge_connected(2,4);
+    solver.two_edge_connected(5,5);
+    solver.insert(1,1);
+    solver.two_edge_connected(0,5);
+
+    std::vector<bool> answers = solver.solve();
+    REQUIRE(answers == std::vector<bool> { true, false, true, false, true, true, false });
+}
+
+TEST_CASE("Offline: matches TwoEdgeConnectivity", "[offline 2-edge]") {
+    const int N = 40;
+    for (int seed = 0; seed < 6; seed++) {
+        std::mt19937 rng(seed);
+        TwoEdgeConnectivity<8> online = TwoEdgeConnectivity<8>(N);
+        OfflineTwoEdgeConnectivity solver = OfflineTwoEdgeConnectivity(N);
+        std::vector<std::shared_ptr<EdgeData>> online_edges;
+        std::vector<int> offline_edges;
+        std::vector<bool> expected;
+
+        for (int step = 0; step < 1500; step++) {
+            int operation = rng() % 3;
+            if (operation == 0 && online_edges.size() < 2 * N) {
+                int u = rng() % N;
+                int v = rng() % N;
+                if (u == v) {
+                    continue;
+                }
+                online_edges.push_back(online.insert(u, v));
+                offline_edges.push_back(solver.insert(u, v));
+            } else if (operation == 1 && !online_edges.empty()) {
+                int i = rng() % online_edges.size();
+                online.remove(online_edges[i]);
+                solver.remove(offline_edges[i]);
+                online_edges.erase(online_edges.begin() + i);
+                offline_edges.erase(offline_edges.begin() + i);
+            } else {
+                int u = rng() % N;
+                int v = rng() % N;
+                expected.push_back(online.two_edge_connected(u, v));
+                REQUIRE(solver.two_edge_connected(u, v) == expected.size() - 1);
+            }
+        }
+        REQUIRE(solver.solve() == expected);
+    }
+}
@@ -0,0 +1,107 @@
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+#include "part_size.h"
+#include "two_edge_connected.h"
+
+template<int L>
+void require_equal(const DensePartSize<L>& dense, const SparsePartSize<L>& sparse) {
+    for (int i = 0; i < L + 2; i++) {
+        for (int j = 0; j < L; j++) {
+            REQUIRE(dense.get(i, j) == sparse.get(i, j));
+        }
+    }
+}
+
+TEST_CASE("Part size: sparse matches dense", "[part size]") {
+    const int L = 6;
+    std::mt19937 rng(3);
+    DensePartSize<L> dense[3];
+    SparsePartSize<L> sparse[3];
+
+    for (int step = 0; step < 2000; step++) {
+        int k = rng() % 3;
+        int row = rng() % (L + 2);
+        switch (rng() % 6) {
+            case 0: {
+                dense[k].clear();
+                sparse[k].clear();
+                break;
+            }
+            case 1: {
+                int value = rng() % 10;
+                dense[k].fill_row(row, value);
+                sparse[k].fill_row(row, value);
+                break;
+            }
+            case 2: {
+                // Non-increasing like the size of a point cluster
+                int values[L];
+                values[0] = rng() % 20;
+                for (int j = 1; j < L; j++) {
+                    values[j] = values[j - 1] - rng() % 3;
+                }
+                dense[k].set_row(row, values);
+                sparse[k].set_row(row, values);
+                break;
+            }
+            case 3: {
+                int start = rng() % (L + 2);
+                int end = start + rng() % (L + 2 - start);
+                int target = start == 0 ? end : 0;
+                if (target == end && end == L + 2) {
+                    break;
+                }
+                dense[k].collapse_rows(target, start, end);
+                sparse[k].collapse_rows(target, start, end);
+                break;
+            }
+            case 4: {
+                int owner = (k + 1) % 3;
+                int other = (k + 2) % 3;
+                dense[k].combine(dense[owner], dense[other], row);
+                sparse[k].combine(sparse[owner], sparse[other], row);
+                break;
+            }
+            case 5: {
+                std::vector<int> dense_sum(L, 1);
+                std::vector<int> sparse_sum(L, 1);
+                dense[k].add_lower_triangle(dense_sum.data());
+                sparse[k].add_lower_triangle(sparse_sum.data());
+                REQUIRE(dense_sum == sparse_sum);
+                break;
+            }
+        }
+        require_equal(dense[k], sparse[k]);
+    }
+}
+
+TEST_CASE("Part size: sparse graph matches dense graph", "[part size]") {
+    const int N = 100;
+    std::mt19937 rng(11);
+    TwoEdgeConnectivity<8, DensePartSize<8>> dense = TwoEdgeConnectivity<8, DensePartSize<8>>(N);
+    TwoEdgeConnectivity<8, SparsePartSize<8>> sparse = TwoEdgeConnectivity<8, SparsePartSize<8>>(N);
+    std::vector<std::shared_ptr<EdgeData>> dense_edges;
+    std::vector<std::shared_ptr<EdgeData>> sparse_edges;
+
+    for (int step = 0; step < 600; step++) {
+        if (dense_edges.empty() || rng() % 3 != 0) {
+            int u = rng() % N;
+            int v = rng() % N;
+            dense_edges.push_back(dense.insert(u, v));
+            sparse_edges.push_back(sparse.insert(u, v));
+        } else {
+            int i = rng() % dense_edges.size();
+            dense.remove(dense_edges[i]);
+            sparse.remove(sparse_edges[i]);
+            dense_edges.erase(dense_edges.begin() + i);
+            sparse_edges.erase(sparse_edges.begin() + i);
+        }
+        int u = rng() % N;
+        int v = rng() % N;
+        REQUIRE(dense.two_edge_connected(u, v) == sparse.two_edge_connected(u, v));
+        int level = rng() % 8;
+        REQUIRE(dense.find_size(u, u, level) == sparse.find_size(u, u, level));
+    }
+}
@@ -1,7 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
 #include <iostream>
 #include <deque>
+#include <numeric>
+#include <set>
 #include <random>
+#include <thread>
 #include "two_edge_connected.h"
 
 bool has_endpoints(TreeEdgeData* bridge, int u, int v) {
@@ -369,4 +373,384 @@ TEST_CASE("2-edge: cycle check", "[2-edge]") {
             edges.push_back(tree.insert(j, (j + 1) % N));
         }
     }    
-}
\ No newline at end of file
+}
+TEST_CASE("2-edge: different level bounds in one process", "[2-edge]") {
+    TwoEdgeConnectivity<4> small = TwoEdgeConnectivity<4>(8);
+    TwoEdgeConnectivity<8> large = TwoEdgeConnectivity<8>(300);
+
+    std::vector<std::shared_ptr<EdgeData>> small_edges;
+    std::vector<std::shared_ptr<EdgeData>> large_edges;
+    for (int i = 0; i < 8; i++) {
+        small_edges.push_back(small.insert(i, (i + 1) % 8));
+    }
+    for (int i = 0; i < 300; i++) {
+        large_edges.push_back(large.insert(i, (i + 1) % 300));
+    }
+    REQUIRE(small.two_edge_connected(0, 4));
+    REQUIRE(large.two_edge_connected(0, 150));
+
+    small.remove(small_edges[2]);
+    large.remove(large_edges[100]);
+    REQUIRE(!small.two_edge_connected(0, 4));
+    REQUIRE(large.find_bridge(0, 150) != nullptr);
+    REQUIRE(!large.two_edge_connected(0, 150));
+
+    int bound = with_two_edge_connectivity(1000, [](auto& graph) {
+        graph.insert(0, 999);
+        graph.insert(999, 0);
+        REQUIRE(graph.two_edge_connected(0, 999));
+        return graph.find_bridge(0, 999) == nullptr ? 9 : -1;
+    });
+    REQUIRE(bound == 9);
+}
+
+TEST_CASE("2-edge: independent instances on threads", "[2-edge]") {
+    const int num_threads = 4;
+    const int N = 64;
+    std::vector<int> failures(num_threads, 0);
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < num_threads; t++) {
+        workers.emplace_back([&failures, t, N]() {
+            TwoEdgeConnectivity<8> tree = TwoEdgeConnectivity<8>(N);
+            std::deque<std::shared_ptr<EdgeData>> edges;
+            for (int i = 0; i < N; i++) {
+                edges.push_back(tree.insert(i, (i + 1 + t) % N));
+            }
+            for (int j = 0; j < N; j++) {
+                failures[t] += !tree.two_edge_connected(j, (j + 1 + t) % N);
+                tree.remove(edges.front());
+                edges.pop_front();
+                failures[t] += tree.two_edge_connected(j, (j + 1 + t) % N);
+                edges.push_back(tree.insert(j, (j + 1 + t) % N));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (int t = 0; t < num_threads; t++) {
+        REQUIRE(failures[t] == 0);
+    }
+}
+
+TEST_CASE("2-edge: bridges only matches all features", "[2-edge]") {
+    const int N = 80;
+    std::mt19937 rng(13);
+    TwoEdgeConnectivity<8, DensePartSize<8>, AllFeatures> full = TwoEdgeConnectivity<8, DensePartSize<8>, AllFeatures>(N);
+    TwoEdgeConnectivity<8, SparsePartSize<8>, BridgesOnly> bridges = TwoEdgeConnectivity<8, SparsePartSize<8>, BridgesOnly>(N);
+    // Connected from the start, so that find_bridge is defined for every pair.
+    for (int i = 1; i < N; i++) {
+        int parent = rng() % i;
+        full.insert(i, parent);
+        bridges.insert(i, parent);
+    }
+
+    for (int step = 0; step < 150; step++) {
+        int u = rng() % N;
+        int v = rng() % N;
+        full.insert(u, v);
+        bridges.insert(u, v);
+        for (int q = 0; q < 5; q++) {
+            int x = rng() % N;
+            int y = rng() % N;
+            REQUIRE(full.two_edge_connected(x, y) == bridges.two_edge_connected(x, y));
+            if (x != y) {
+                REQUIRE((full.find_bridge(x, y) == nullptr) == (bridges.find_bridge(x, y) == nullptr));
+            }
+        }
+    }
+}
+
+TEST_CASE("2-edge: small components match the top tree", "[2-edge]") {
+    const int N = 150;
+    for (int limit : { 8, 64 }) {
+        std::mt19937 rng(limit);
+        TwoEdgeConnectivity<8> expected = TwoEdgeConnectivity<8>(N);
+        TwoEdgeConnectivity<8> tree = TwoEdgeConnectivity<8>(N, limit);
+        std::vector<std::shared_ptr<EdgeData>> expected_edges;
+        std::vector<std::shared_ptr<EdgeData>> edges;
+
+        for (int step = 0; step < 2000; step++) {
+            // Mostly short edges, so that many components stay below the limit.
+            int u = rng() % N;
+            int v = rng() % 4 == 0 ? rng() % N : (u + 1 + rng() % 3) % N;
+            if (rng() % 3 == 0 && !edges.empty()) {
+                int i = rng() % edges.size();
+                expected.remove(expected_edges[i]);
+                tree.remove(edges[i]);
+                expected_edges.erase(expected_edges.begin() + i);
+                edges.erase(edges.begin() + i);
+            } else if (u != v) {
+                expected_edges.push_back(expected.insert(u, v));
+                edges.push_back(tree.insert(u, v));
+            }
+            for (int q = 0; q < 3; q++) {
+                int x = rng() % N;
+                int y = rng() % 4 == 0 ? rng() % N : (x + 1 + rng() % 3) % N;
+                REQUIRE(tree.two_edge_connected(x, y) == expected.two_edge_connected(x, y));
+            }
+        }
+    }
+}
+
+TEST_CASE("2-edge: small component promoted by find_bridge", "[2-edge]") {
+    TwoEdgeConnectivity<4> tree = TwoEdgeConnectivity<4>(10, 16);
+    tree.insert(0,1);
+    tree.insert(1,2);
+    auto edge = tree.insert(2,0);
+    tree.insert(2,3);
+    REQUIRE(edge->edge_type == SmallComponentEdge);
+    REQUIRE(tree.two_edge_connected(0,2));
+    REQUIRE(!tree.two_edge_connected(0,3));
+
+    auto bridge = tree.find_bridge(0,3);
+    REQUIRE(has_endpoints(bridge, 2, 3));
+    REQUIRE(edge->edge_type != SmallComponentEdge);
+    tree.remove(edge);
+    REQUIRE(!tree.two_edge_connected(0,2));
+    tree.insert(3,0);
+    REQUIRE(tree.two_edge_connected(1,3));
+}
+
+// Brute force: components of the graph without edge 'skip', as the smallest vertex of each.
+std::vector<int> components_without(int n, const std::vector<std::pair<int,int>>& edges, int skip, const std::vector<char>& removed) {
+    std::vector<std::vector<int>> adjacent(n);
+    for (int i = 0; i < edges.size(); i++) {
+        if (i != skip && !removed[i]) {
+            adjacent[edges[i].first].push_back(edges[i].second);
+            adjacent[edges[i].second].push_back(edges[i].first);
+        }
+    }
+    std::vector<int> component(n, -1);
+    for (int s = 0; s < n; s++) {
+        if (component[s] != -1) {
+            continue;
+        }
+        std::deque<int> todo = { s };
+        component[s] = s;
+        while (!todo.empty()) {
+            int v = todo.front();
+            todo.pop_front();
+            for (int w : adjacent[v]) {
+                if (component[w] == -1) {
+                    component[w] = s;
+                    todo.push_back(w);
+                }
+            }
+        }
+    }
+    return component;
+}
+
+std::set<std::pair<int,int>> as_pairs(const std::vector<TreeEdgeData*>& bridges) {
+    std::set<std::pair<int,int>> pairs;
+    for (TreeEdgeData* bridge : bridges) {
+        pairs.insert({ std::min(bridge->endpoints[0], bridge->endpoints[1]), std::max(bridge->endpoints[0], bridge->endpoints[1]) });
+    }
+    REQUIRE(pairs.size() == bridges.size());
+    return pairs;
+}
+
+TEST_CASE("2-edge: enumerate bridges and components", "[2-edge]") {
+    const int N = 60;
+    for (int limit : { 0, 16 }) {
+        std::mt19937 rng(7 + limit);
+        TwoEdgeConnectivity<8> tree = TwoEdgeConnectivity<8>(N, limit);
+        std::vector<std::pair<int,int>> edges;
+        std::vector<std::shared_ptr<EdgeData>> handles;
+        std::vector<char> removed;
+
+        for (int round = 0; round < 12; round++) {
+            for (int i = 0; i < 8; i++) {
+                int u = rng() % N;
+                int v = rng() % 3 == 0 ? rng() % N : (u + 1) % N;
+                if (u != v) {
+                    edges.push_back({ u, v });
+                    handles.push_back(tree.insert(u, v));
+                    removed.push_back(false);
+                }
+            }
+            for (int i = 0; i < 3; i++) {
+                int e = rng() % edges.size();
+                if (!removed[e]) {
+                    tree.remove(handles[e]);
+                    removed[e] = true;
+                }
+            }
+
+            std::vector<int> component = components_without(N, edges, -1, removed);
+            std::vector<std::vector<int>> bridge_split; // Per bridge, the components without it
+            std::vector<std::pair<int,int>> bridges;
+            std::vector<char> not_bridge(edges.size(), true);
+            for (int e = 0; e < edges.size(); e++) {
+                if (removed[e]) {
+                    continue;
+                }
+                std::vector<int> without = components_without(N, edges, e, removed);
+                if (without[edges[e].first] != without[edges[e].second]) {
+                    bridges.push_back({ std::min(edges[e].first, edges[e].second), std::max(edges[e].first, edges[e].second) });
+                    bridge_split.push_back(without);
+                    not_bridge[e] = false;
+                }
+            }
+
+            for (int q = 0; q < 10; q++) {
+                int u = rng() % N;
+                int v = rng() % N;
+                std::set<std::pair<int,int>> expected_path, expected_component;
+                for (int b = 0; b < bridges.size(); b++) {
+                    if (component[bridges[b].first] == component[u]) {
+                        expected_component.insert(bridges[b]);
+                        if (bridge_split[b][u] != bridge_split[b][v]) {
+                            expected_path.insert(bridges[b]);
+                        }
+                    }
+                }
+                if (component[u] != component[v]) {
+                    expected_path.clear();
+                }
+                REQUIRE(as_pairs(tree.find_bridges(u, v)) == expected_path);
+                REQUIRE(as_pairs(tree.find_bridges(u)) == expected_component);
+                REQUIRE(tree.count_bridges(u, v) == expected_path.size());
+                REQUIRE(tree.count_bridges(u) == expected_component.size());
+                TreeEdgeData* bridge = tree.find_bridge(u);
+                REQUIRE((bridge == nullptr) == expected_component.empty());
+                if (bridge) {
+                    REQUIRE(expected_component.count(*as_pairs({ bridge }).begin()));
+                }
+            }
+
+            std::vector<char> without_bridges(removed);
+            for (int e = 0; e < edges.size(); e++) {
+                without_bridges[e] = removed[e] || !not_bridge[e];
+            }
+            REQUIRE(tree.two_edge_component_ids() == components_without(N, edges, -1, without_bridges));
+        }
+    }
+}
+
+TEST_CASE("2-edge: bridge tree deltas", "[2-edge]") {
+    const int N = 50;
+    std::mt19937 rng(21);
+    TwoEdgeConnectivity<8> tree = TwoEdgeConnectivity<8>(N, 8);
+    std::vector<std::pair<int,int>> edges;
+    std::vector<std::shared_ptr<EdgeData>> handles;
+    std::vector<char> removed;
+
+    // Bridges as sorted pairs, kept up to date from the deltas only.
+    std::set<std::pair<int,int>> bridges;
+    auto sorted = [](int u, int v) { return std::make_pair(std::min(u, v), std::max(u, v)); };
+
+    for (int i = 0; i < 30; i++) {
+        int u = rng() % N;
+        int v = (u + 1 + rng() % 3) % N;
+        edges.push_back({ u, v });
+        handles.push_back(tree.insert(u, v));
+        removed.push_back(false);
+    }
+    BridgeTree snapshot = tree.bridge_tree();
+    for (auto bridge : snapshot.bridges) {
+        bridges.insert(sorted(bridge[0], bridge[1]));
+    }
+    tree.track_bridges(true);
+
+    for (int step = 0; step < 300; step++) {
+        if (rng() % 2) {
+            int u = rng() % N;
+            int v = rng() % 4 == 0 ? rng() % N : (u + 1 + rng() % 3) % N;
+            if (u == v) {
+                continue;
+            }
+            edges.push_back({ u, v });
+            handles.push_back(tree.insert(u, v));
+            removed.push_back(false);
+        } else {
+            int e = rng() % edges.size();
+            if (removed[e]) {
+                continue;
+            }
+            tree.remove(handles[e]);
+            removed[e] = true;
+        }
+        for (BridgeDelta delta : tree.take_bridge_deltas()) {
+            std::pair<int,int> bridge = sorted(delta.endpoints[0], delta.endpoints[1]);
+            if (delta.kind == BridgeDelta::Linked || delta.kind == BridgeDelta::Split) {
+                REQUIRE(bridges.insert(bridge).second);
+            } else {
+                REQUIRE(bridges.erase(bridge) == 1);
+            }
+        }
+
+        if (step % 10 == 0) {
+            std::set<std::pair<int,int>> expected;
+            for (int e = 0; e < edges.size(); e++) {
+                if (removed[e]) {
+                    continue;
+                }
+                std::vector<int> without = components_without(N, edges, e, removed);
+                if (without[edges[e].first] != without[edges[e].second]) {
+                    expected.insert(sorted(edges[e].first, edges[e].second));
+                }
+            }
+            REQUIRE(bridges == expected);
+            snapshot = tree.bridge_tree();
+            std::set<std::pair<int,int>> snapshot_bridges;
+            for (auto bridge : snapshot.bridges) {
+                snapshot_bridges.insert(sorted(bridge[0], bridge[1]));
+            }
+            REQUIRE(snapshot_bridges == expected);
+            REQUIRE(snapshot.component == tree.two_edge_component_ids());
+        }
+    }
+}
+
+TEST_CASE("2-edge: bridge counts without the other aggregates", "[2-edge]") {
+    const int N = 80;
+    std::mt19937 rng(31);
+    TwoEdgeConnectivity<8> full = TwoEdgeConnectivity<8>(N);
+    TwoEdgeConnectivity<8, SparsePartSize<8>, BridgeCounts> counts = TwoEdgeConnectivity<8, SparsePartSize<8>, BridgeCounts>(N);
+    for (int step = 0; step < 200; step++) {
+        int u = rng() % N;
+        int v = rng() % 3 == 0 ? rng() % N : (u + 1) % N;
+        if (u != v) {
+            full.insert(u, v);
+            counts.insert(u, v);
+        }
+        int x = rng() % N;
+        int y = rng() % N;
+        REQUIRE(counts.count_bridges(x, y) == full.find_bridges(x, y).size());
+        REQUIRE(counts.count_bridges(x) == full.find_bridges(x).size());
+    }
+}
+
+TEST_CASE("2-edge: bridge counts of a set of vertices", "[2-edge]") {
+    const int N = 80;
+    std::mt19937 rng(37);
+    TwoEdgeConnectivity<8> tree = TwoEdgeConnectivity<8>(N);
+    std::vector<int> component(N);
+    std::iota(component.begin(), component.end(), 0);
+    for (int step = 0; step < 200; step++) {
+        int u = rng() % N;
+        int v = rng() % 3 == 0 ? rng() % N : (u + 1) % N;
+        if (u != v) {
+            tree.insert(u, v);
+            int from = component[u];
+            std::replace(component.begin(), component.end(), from, component[v]);
+        }
+        std::vector<int> vertices(1 + rng() % 5);
+        for (int& vertex : vertices) {
+            vertex = rng() % N;
+        }
+        // The union of the bridges on the paths from the first vertex.
+        std::set<TreeEdgeData*> expected;
+        bool connected = true;
+        for (int vertex : vertices) {
+            connected = connected && component[vertex] == component[vertices[0]];
+            for (TreeEdgeData* bridge : tree.find_bridges(vertices[0], vertex)) {
+                expected.insert(bridge);
+            }
+        }
+        REQUIRE(tree.count_bridges(vertices) == (connected ? expected.size() : 0));
+    }
+}
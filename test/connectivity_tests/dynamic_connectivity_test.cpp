@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+#include "dynamic_connectivity.h"
+
+// Component ids by depth first search over the current edges.
+static std::vector<int> components(int n, const std::vector<std::pair<int,int>>& edges) {
+    std::vector<std::vector<int>> adjacent(n);
+    for (auto& edge : edges) {
+        adjacent[edge.first].push_back(edge.second);
+        adjacent[edge.second].push_back(edge.first);
+    }
+    std::vector<int> component(n, -1);
+    for (int root = 0; root < n; root++) {
+        if (component[root] != -1) {
+            continue;
+        }
+        std::vector<int> stack = { root };
+        component[root] = root;
+        while (!stack.empty()) {
+            int x = stack.back();
+            stack.pop_back();
+            for (int y : adjacent[x]) {
+                if (component[y] == -1) {
+                    component[y] = root;
+                    stack.push_back(y);
+                }
+            }
+        }
+    }
+    return component;
+}
+
+TEST_CASE("Dynamic connectivity: small", "[dynamic connectivity]") {
+    DynamicConnectivity graph = DynamicConnectivity(6);
+    REQUIRE(graph.insert(1,1) == nullptr);
+    auto a = graph.insert(0,1);
+    auto b = graph.insert(1,2);
+    auto c = graph.insert(2,0);
+    graph.insert(3,4);
+    REQUIRE(graph.connected(0,2));
+    REQUIRE(!graph.connected(0,3));
+
+    // Tree edge with a replacement.
+    REQUIRE(a->edge_type == TreeEdge);
+    graph.remove(a);
+    REQUIRE(graph.connected(0,1));
+    graph.remove(c);
+    REQUIRE(!graph.connected(0,1));
+    REQUIRE(graph.connected(1,2));
+
+    graph.insert(2,3);
+    REQUIRE(graph.connected(1,4));
+    graph.remove(b);
+    REQUIRE(!graph.connected(1,4));
+    REQUIRE(graph.connected(2,4));
+    REQUIRE(!graph.connected(5,0));
+}
+
+TEST_CASE("Dynamic connectivity: matches depth first search", "[dynamic connectivity]") {
+    for (int seed = 0; seed < 10; seed++) {
+        std::mt19937 rng(seed);
+        const int N = 10 + 20 * seed;
+        DynamicConnectivity<8> graph = DynamicConnectivity<8>(N);
+        std::vector<std::pair<int,int>> edges;
+        std::vector<std::shared_ptr<EdgeData>> handles;
+
+        for (int step = 0; step < 400; step++) {
+            // Around one edge per vertex, near the point where components merge and split.
+            if (edges.empty() || (edges.size() < N && rng() % 2 == 0)) {
+                int u = rng() % N;
+                int v = rng() % N;
+                if (u == v) {
+                    continue;
+                }
+                edges.push_back({ u, v });
+                handles.push_back(graph.insert(u, v));
+            } else {
+                int i = rng() % edges.size();
+                graph.remove(handles[i]);
+                edges[i] = edges.back();
+                handles[i] = handles.back();
+                edges.pop_back();
+                handles.pop_back();
+            }
+            std::vector<int> component = components(N, edges);
+            for (int q = 0; q < 20; q++) {
+                int u = rng() % N;
+                int v = rng() % N;
+                REQUIRE(graph.connected(u, v) == (component[u] == component[v]));
+            }
+        }
+    }
+}
+
+TEST_CASE("Dynamic connectivity: dense graphs raise levels", "[dynamic connectivity]") {
+    for (int seed = 0; seed < 5; seed++) {
+        std::mt19937 rng(seed);
+        const int N = 64 + 64 * seed;
+        DynamicConnectivity<9> graph = DynamicConnectivity<9>(N);
+        std::vector<std::pair<int,int>> edges;
+        std::vector<std::shared_ptr<EdgeData>> handles;
+
+        // Two to three edges per vertex, so removed tree edges have replacements on
+        // several levels.
+        for (int step = 0; step < 3000; step++) {
+            if (edges.size() < 2 * N || (edges.size() < 3 * N && rng() % 2 == 0)) {
+                int u = rng() % N;
+                int v = rng() % N;
+                if (u == v) {
+                    continue;
+                }
+                edges.push_back({ u, v });
+                handles.push_back(graph.insert(u, v));
+            } else {
+                int i = rng() % edges.size();
+                graph.remove(handles[i]);
+                edges[i] = edges.back();
+                handles[i] = handles.back();
+                edges.pop_back();
+                handles.pop_back();
+            }
+            if (step % 10 != 0) {
+                continue;
+            }
+            std::vector<int> component = components(N, edges);
+            for (int q = 0; q < 20; q++) {
+                int u = rng() % N;
+                int v = rng() % N;
+                REQUIRE(graph.connected(u, v) == (component[u] == component[v]));
+            }
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "dynamic_msf.h"
+
+// Weight of a minimum spanning forest by Kruskal's algorithm.
+static long long kruskal(int n, std::vector<std::tuple<int,int,int>> edges) {
+    std::sort(edges.begin(), edges.end(), [](auto& a, auto& b) { return std::get<2>(a) < std::get<2>(b); });
+    std::vector<int> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int v) {
+        while (parent[v] != v) {
+            v = parent[v] = parent[parent[v]];
+        }
+        return v;
+    };
+    long long weight = 0;
+    for (auto& [u, v, w] : edges) {
+        if (find(u) != find(v)) {
+            parent[find(u)] = find(v);
+            weight += w;
+        }
+    }
+    return weight;
+}
+
+TEST_CASE("Dynamic MSF: small", "[dynamic msf]") {
+    DynamicMSF graph = DynamicMSF(5);
+    REQUIRE(graph.insert(2,2,1) == nullptr);
+    auto a = graph.insert(0,1,5);
+    auto b = graph.insert(1,2,4);
+    auto c = graph.insert(2,0,3);
+    // The cycle drops its heaviest edge.
+    REQUIRE(graph.forest_weight() == 7);
+    REQUIRE(a->edge_type == NonTreeEdge);
+    REQUIRE(c->edge_type == TreeEdge);
+
+    graph.remove(b);
+    REQUIRE(graph.forest_weight() == 8);
+    REQUIRE(a->edge_type == TreeEdge);
+
+    graph.insert(3,4,1);
+    graph.insert(1,3,10);
+    auto d = graph.insert(2,4,2);
+    REQUIRE(graph.forest_weight() == 11);
+    graph.remove(d);
+    REQUIRE(graph.forest_weight() == 19);
+    REQUIRE(graph.connected(0,4));
+}
+
+TEST_CASE("Dynamic MSF: matches Kruskal", "[dynamic msf]") {
+    for (int seed = 0; seed < 10; seed++) {
+        std::mt19937 rng(seed);
+        const int N = 8 + 12 * seed;
+        DynamicMSF<8> graph = DynamicMSF<8>(N);
+        std::vector<std::tuple<int,int,int>> edges;
+        std::vector<std::shared_ptr<WeightedEdgeData>> handles;
+
+        for (int step = 0; step < 400; step++) {
+            // Up to two edges per vertex, with repeated weights.
+            if (edges.empty() || (edges.size() < 2 * N && rng() % 2 == 0)) {
+                int u = rng() % N;
+                int v = rng() % N;
+                int w = rng() % 20;
+                if (u == v) {
+                    continue;
+                }
+                edges.push_back({ u, v, w });
+                handles.push_back(graph.insert(u, v, w));
+            } else {
+                int i = rng() % edges.size();
+                graph.remove(handles[i]);
+                edges[i] = edges.back();
+                handles[i] = handles.back();
+                edges.pop_back();
+                handles.pop_back();
+            }
+            REQUIRE(graph.forest_weight() == kruskal(N, edges));
+        }
+    }
+}
+
+TEST_CASE("Dynamic MSF: removing tree edges of dense graphs", "[dynamic msf]") {
+    for (int seed = 0; seed < 10; seed++) {
+        std::mt19937 rng(seed);
+        const int N = 10 + 10 * seed;
+        DynamicMSF<8> graph = DynamicMSF<8>(N);
+        std::vector<std::tuple<int,int,int>> edges;
+        std::vector<std::shared_ptr<WeightedEdgeData>> handles;
+
+        for (int step = 0; step < 600; step++) {
+            // Many non-tree edges across every cut, so the replacement is picked by weight.
+            if (edges.empty() || (edges.size() < 4 * N && rng() % 3 != 0)) {
+                int u = rng() % N;
+                int v = rng() % N;
+                int w = rng() % 1000;
+                if (u == v) {
+                    continue;
+                }
+                edges.push_back({ u, v, w });
+                handles.push_back(graph.insert(u, v, w));
+            } else {
+                int i = rng() % edges.size();
+                while (handles[i]->edge_type != TreeEdge) {
+                    i = (i + 1) % edges.size();
+                }
+                graph.remove(handles[i]);
+                edges[i] = edges.back();
+                handles[i] = handles.back();
+                edges.pop_back();
+                handles.pop_back();
+            }
+            REQUIRE(graph.forest_weight() == kruskal(N, edges));
+        }
+    }
+}
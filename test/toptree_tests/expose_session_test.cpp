@@ -0,0 +1,191 @@
+#include <catch2/catch_test_macros.hpp>
+#include "top_tree.h"
+#include <algorithm>
+#include <climits>
+#include <random>
+#include <vector>
+#include "add_weight_cluster.hpp"
+
+typedef TopTree<AddWeightCluster,int,None>::ExposeSession AddWeightSession;
+
+TEST_CASE("Expose session queries and updates", "[expose session]") {
+    MaxPathTopTree top_tree = MaxPathTopTree(10);
+    top_tree.link(0, 1, 2);
+    top_tree.link(1, 2, 2);
+    top_tree.link(1, 3, 3);
+    top_tree.link(3, 8, 1);
+    top_tree.link(8, 9, 2);
+    top_tree.link(3, 4, 5);
+    top_tree.link(4, 5, 1);
+
+    {
+        AddWeightSession session(top_tree, 0, 9);
+        REQUIRE(session.connected());
+        REQUIRE(session.get_root()->max_weight == 3);
+        session.get_root()->add_weight(10);
+        REQUIRE(session.get_root()->max_weight == 13);
+
+        // Keeps 9 exposed.
+        REQUIRE(session.retarget(5, 9)->max_weight == 12);
+        // Keeps 5 exposed, on the other side.
+        REQUIRE(session.retarget(5, 2)->max_weight == 13);
+        REQUIRE(session.retarget(2, 5)->max_weight == 13);
+        REQUIRE(session.retarget(4, 5)->max_weight == 1);
+        session.get_root()->add_weight(1);
+
+        // Vertex 6 is not linked yet.
+        session.retarget(5, 6);
+        REQUIRE(!session.connected());
+        REQUIRE(session.get_root() == nullptr);
+    }
+
+    // The session left nothing exposed.
+    top_tree.link(5, 6, 1);
+    AddWeightCluster* root = top_tree.expose(6, 0);
+    REQUIRE(root->max_weight == 13);
+    top_tree.deexpose(6, 0);
+    root = top_tree.expose(4, 6);
+    REQUIRE(root->max_weight == 2);
+    top_tree.deexpose(4, 6);
+}
+
+TEST_CASE("Expose session on a single vertex", "[expose session]") {
+    MaxPathTopTree top_tree = MaxPathTopTree(4);
+    top_tree.link(0, 1, 2);
+    top_tree.link(1, 2, 4);
+
+    AddWeightSession session(top_tree, 1);
+    REQUIRE(session.connected());
+    REQUIRE(session.get_root()->get_num_boundary_vertices() == 1);
+
+    REQUIRE(session.retarget(1, 2)->max_weight == 4);
+    REQUIRE(session.retarget(2)->get_num_boundary_vertices() == 1);
+    REQUIRE(session.retarget(3) == nullptr);
+    REQUIRE(session.retarget(0, 2)->max_weight == 4);
+}
+
+TEST_CASE("Expose session matches expose and deexpose", "[expose session]") {
+    int n = 60;
+    std::mt19937 gen(7);
+    for (int round = 0; round < 20; round++) {
+        MaxPathTopTree session_tree = MaxPathTopTree(n);
+        MaxPathTopTree plain_tree = MaxPathTopTree(n);
+        // A forest, vertices not linked to a smaller one start a new tree.
+        for (int i = 1; i < n; i++) {
+            if (gen() % 8 == 0) {
+                continue;
+            }
+            int parent = gen() % i;
+            int weight = gen() % 100;
+            session_tree.link(i, parent, weight);
+            plain_tree.link(i, parent, weight);
+        }
+
+        int u = gen() % n;
+        int v = gen() % n;
+        AddWeightSession session(session_tree, u, v);
+        for (int step = 0; step < 200; step++) {
+            // Mostly move one end, as a chain of queries would.
+            int x = gen() % n;
+            switch (gen() % 3) {
+                case 0: u = x; break;
+                case 1: v = x; break;
+                default: std::swap(u, v); break;
+            }
+            if (u == v) {
+                continue;
+            }
+            AddWeightCluster* root = session.retarget(u, v);
+            bool connected = plain_tree.connected(u, v);
+            REQUIRE(session.connected() == connected);
+            if (!connected) {
+                continue;
+            }
+            AddWeightCluster* plain_root = plain_tree.expose(u, v);
+            REQUIRE(root->max_weight == plain_root->max_weight);
+            if (gen() % 4 == 0) {
+                int weight = gen() % 10;
+                root->add_weight(weight);
+                plain_root->add_weight(weight);
+            }
+            plain_tree.deexpose(u, v);
+        }
+    }
+}
+
+TEST_CASE("Exposures in separate trees", "[expose session]") {
+    MaxPathTopTree top_tree = MaxPathTopTree(12);
+    // Trees {0,1,2,3}, {4,5,6} and {7,8}, vertices 9 to 11 are isolated.
+    top_tree.link(0, 1, 4);
+    top_tree.link(1, 2, 1);
+    top_tree.link(2, 3, 6);
+    top_tree.link(4, 5, 2);
+    top_tree.link(5, 6, 7);
+    top_tree.link(7, 8, 3);
+
+    AddWeightSession first(top_tree, 0, 3);
+    AddWeightSession second(top_tree, 6, 4);
+    REQUIRE(first.get_root()->max_weight == 6);
+    REQUIRE(second.get_root()->max_weight == 7);
+
+    // Updates in one tree leave the other alone.
+    first.get_root()->add_weight(10);
+    REQUIRE(second.retarget(5, 4)->max_weight == 2);
+    REQUIRE(first.retarget(0, 1)->max_weight == 14);
+
+    // Trees without exposed vertices can be changed meanwhile, and exposed directly.
+    top_tree.link(8, 9, 5);
+    AddWeightCluster* root = top_tree.expose(7, 9);
+    REQUIRE(root->max_weight == 5);
+    top_tree.deexpose(7, 9);
+    top_tree.cut(7, 8);
+    top_tree.link(9, 10, 1);
+    REQUIRE(top_tree.connected(8, 10));
+    REQUIRE(!top_tree.connected(7, 10));
+
+    // A single exposed vertex in each of two trees.
+    AddWeightCluster* root_7 = top_tree.expose(7);
+    AddWeightCluster* root_10 = top_tree.expose(10);
+    REQUIRE(root_7 == nullptr);
+    REQUIRE(root_10->get_num_boundary_vertices() == 1);
+    top_tree.deexpose(10);
+    top_tree.deexpose(7);
+
+    REQUIRE(first.retarget(2, 3)->max_weight == 16);
+    REQUIRE(second.retarget(6, 5)->max_weight == 7);
+}
+
+TEST_CASE("Connected on a long path during a session", "[expose session]") {
+    // Linked in order, so the leaves start out deep enough for connected to splay them.
+    const int n = 3000;
+    MaxPathTopTree top_tree = MaxPathTopTree(n + 1);
+    std::vector<int> weights(n - 1);
+    for (int i = 0; i + 1 < n; i++) {
+        weights[i] = i % 97;
+        top_tree.link(i, i + 1, weights[i]);
+    }
+    std::mt19937 gen(3);
+    {
+        AddWeightSession session(top_tree, 0, n - 1);
+        session.get_root()->add_weight(5);
+        for (int i = 0; i < 20000; i++) {
+            int u = gen() % (n + 1);
+            int v = gen() % (n + 1);
+            REQUIRE(top_tree.connected(u, v) == (u == v || (u < n && v < n)));
+        }
+        REQUIRE(session.get_root()->max_weight == 96 + 5);
+    }
+    for (int i = 0; i < 50; i++) {
+        int u = gen() % n;
+        int v = gen() % n;
+        if (u == v) {
+            continue;
+        }
+        int expected = INT_MIN;
+        for (int j = std::min(u, v); j < std::max(u, v); j++) {
+            expected = std::max(expected, weights[j] + 5);
+        }
+        REQUIRE(top_tree.expose(u, v)->max_weight == expected);
+        top_tree.deexpose(u, v);
+    }
+}
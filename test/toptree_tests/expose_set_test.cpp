@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+#include "top_tree.h"
+#include <algorithm>
+#include <climits>
+#include <random>
+#include <vector>
+
+// Sum, number and maximum of the edge weights on the cluster path.
+struct PathSumCluster : Node<PathSumCluster, int, None> {
+    long long sum;
+    int edges;
+    int max_weight;
+
+    void create(int* edge_data, None* left, None* right) {
+        bool path = this->is_path();
+        this->sum = path ? *edge_data : 0;
+        this->edges = path ? 1 : 0;
+        this->max_weight = path ? *edge_data : INT_MIN;
+    }
+
+    void merge(PathSumCluster* left, PathSumCluster* right) {
+        this->sum = 0;
+        this->edges = 0;
+        this->max_weight = INT_MIN;
+        for (PathSumCluster* child : {left, right}) {
+            if (child->is_path()) {
+                this->sum += child->sum;
+                this->edges += child->edges;
+                this->max_weight = std::max(this->max_weight, child->max_weight);
+            }
+        }
+    }
+};
+
+struct SteinerResult {
+    bool connected = true;
+    long long sum = 0;
+    int edges = 0;
+    int max_weight = INT_MIN;
+};
+
+// Roots the forest at the first terminal, an edge to a parent is in the smallest subtree
+// spanning the terminals exactly if there is a terminal below it.
+SteinerResult brute_force_steiner(int n, const std::vector<std::vector<std::pair<int,int>>>& adjacent, const std::vector<int>& terminals) {
+    SteinerResult result;
+    std::vector<int> parent(n, -2);
+    std::vector<int> parent_weight(n, 0);
+    std::vector<int> order = {terminals[0]};
+    parent[terminals[0]] = -1;
+    for (int i = 0; i < (int) order.size(); i++) {
+        for (auto [w, weight] : adjacent[order[i]]) {
+            if (parent[w] == -2) {
+                parent[w] = order[i];
+                parent_weight[w] = weight;
+                order.push_back(w);
+            }
+        }
+    }
+    std::vector<int> below(n, 0);
+    for (int terminal : terminals) {
+        if (parent[terminal] == -2) {
+            result.connected = false;
+            return result;
+        }
+        below[terminal] = 1;
+    }
+    for (int i = order.size() - 1; i > 0; i--) {
+        int w = order[i];
+        if (below[w]) {
+            result.sum += parent_weight[w];
+            result.edges++;
+            result.max_weight = std::max(result.max_weight, parent_weight[w]);
+            below[parent[w]] = 1;
+        }
+    }
+    return result;
+}
+
+SteinerResult expose_set_steiner(TopTree<PathSumCluster, int, None>& top_tree, const std::vector<int>& terminals) {
+    SteinerResult result;
+    result.connected = top_tree.expose_set(terminals, [&](PathSumCluster* root) {
+        result.sum += root->sum;
+        result.edges += root->edges;
+        result.max_weight = std::max(result.max_weight, root->max_weight);
+    });
+    return result;
+}
+
+TEST_CASE("Expose set on a small tree", "[expose set]") {
+    TopTree<PathSumCluster, int, None> top_tree = TopTree<PathSumCluster, int, None>(9);
+    // Paths 3 - 1 - 0 - 2 - 5 and 1 - 4 - 6, vertices 7 and 8 are isolated.
+    top_tree.link(0, 1, 1);
+    top_tree.link(0, 2, 2);
+    top_tree.link(1, 3, 4);
+    top_tree.link(1, 4, 8);
+    top_tree.link(2, 5, 16);
+    top_tree.link(4, 6, 32);
+
+    SteinerResult result = expose_set_steiner(top_tree, {3, 6, 5});
+    REQUIRE(result.connected);
+    REQUIRE(result.sum == 4 + 8 + 32 + 1 + 2 + 16);
+    REQUIRE(result.edges == 6);
+
+    result = expose_set_steiner(top_tree, {3, 4, 3, 1});
+    REQUIRE(result.sum == 4 + 8);
+    REQUIRE(result.max_weight == 8);
+
+    result = expose_set_steiner(top_tree, {6});
+    REQUIRE(result.connected);
+    REQUIRE(result.edges == 0);
+
+    int calls = 0;
+    REQUIRE(!top_tree.expose_set({3, 5, 7}, [&](PathSumCluster*) { calls++; }));
+    REQUIRE(!top_tree.expose_set({8, 7}, [&](PathSumCluster*) { calls++; }));
+    REQUIRE(calls == 0);
+
+    // Nothing is left marked or exposed.
+    top_tree.link(5, 7, 64);
+    result = expose_set_steiner(top_tree, {7, 0});
+    REQUIRE(result.sum == 64 + 16 + 2);
+}
+
+TEST_CASE("Expose set matches brute force", "[expose set]") {
+    const int n = 50;
+    std::mt19937 gen(11);
+    for (int round = 0; round < 10; round++) {
+        TopTree<PathSumCluster, int, None> top_tree = TopTree<PathSumCluster, int, None>(n);
+        std::vector<std::vector<std::pair<int,int>>> adjacent(n);
+        std::vector<std::pair<int,int>> edges;
+        for (int i = 1; i < n; i++) {
+            int parent = gen() % i;
+            int weight = gen() % 1000;
+            top_tree.link(i, parent, weight);
+            adjacent[i].push_back({parent, weight});
+            adjacent[parent].push_back({i, weight});
+            edges.push_back({i, parent});
+        }
+        for (int step = 0; step < 200; step++) {
+            // Move an edge, which may leave the forest disconnected for a while.
+            if (step % 4 == 0 && !edges.empty()) {
+                int e = gen() % edges.size();
+                auto [a, b] = edges[e];
+                top_tree.cut(a, b);
+                auto drop = [](std::vector<std::pair<int,int>>& list, int w) {
+                    list.erase(std::find_if(list.begin(), list.end(), [w](auto& p) { return p.first == w; }));
+                };
+                drop(adjacent[a], b);
+                drop(adjacent[b], a);
+                int c = gen() % n;
+                int weight = gen() % 1000;
+                if (c != a && top_tree.link(a, c, weight)) {
+                    adjacent[a].push_back({c, weight});
+                    adjacent[c].push_back({a, weight});
+                    edges[e] = {a, c};
+                } else {
+                    edges.erase(edges.begin() + e);
+                }
+            }
+            std::vector<int> terminals(1 + gen() % 8);
+            for (int& terminal : terminals) {
+                terminal = gen() % n;
+            }
+            SteinerResult expected = brute_force_steiner(n, adjacent, terminals);
+            SteinerResult result = expose_set_steiner(top_tree, terminals);
+            REQUIRE(result.connected == expected.connected);
+            if (expected.connected) {
+                REQUIRE(result.sum == expected.sum);
+                REQUIRE(result.edges == expected.edges);
+                REQUIRE(result.max_weight == expected.max_weight);
+            }
+        }
+    }
+}
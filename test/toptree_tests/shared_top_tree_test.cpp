@@ -0,0 +1,132 @@
+#include <catch2/catch_test_macros.hpp>
+#include "shared_top_tree.h"
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include "add_weight_cluster.hpp"
+
+TEST_CASE("Read only root finding", "[shared top tree]") {
+    const int n = 40;
+    std::mt19937 gen(5);
+    MaxPathTopTree top_tree = MaxPathTopTree(n);
+    for (int i = 1; i < n; i++) {
+        if (gen() % 5 != 0) {
+            top_tree.link(i, gen() % i, gen() % 100);
+        }
+    }
+    for (int u = 0; u < n; u++) {
+        for (int v = 0; v < n; v++) {
+            bool exposed_connected = false;
+            if (u != v) {
+                top_tree.expose(u);
+                AddWeightCluster* root = top_tree.expose(v);
+                exposed_connected = root && root->get_num_boundary_vertices() == 2;
+                top_tree.deexpose(u);
+                top_tree.deexpose(v);
+            }
+            REQUIRE(top_tree.same_tree(u, v) == (u == v || exposed_connected));
+            if (u != v) {
+                AddWeightCluster* root = top_tree.find_root(u);
+                REQUIRE((root && root == top_tree.find_root(v)) == exposed_connected);
+            }
+        }
+    }
+    // Works while vertices are exposed.
+    top_tree.expose(1, 0);
+    REQUIRE(top_tree.same_tree(0, 1));
+    top_tree.deexpose(1, 0);
+
+    MaxPathTopTree isolated = MaxPathTopTree(2);
+    REQUIRE(isolated.find_root(0) == nullptr);
+    REQUIRE(!isolated.same_tree(0, 1));
+    REQUIRE(isolated.same_tree(1, 1));
+}
+
+TEST_CASE("Readers alongside a writer", "[shared top tree]") {
+    // Component c is the path c, c + k, c + 2k, ... The writer cuts and relinks edges, and
+    // moves subpaths within their component, so every write keeps the components.
+    const int n = 400;
+    const int k = 4;
+    SharedTopTree<AddWeightCluster, int, None> shared = SharedTopTree<AddWeightCluster, int, None>(n);
+    std::vector<int> parent(n, -1);
+    shared.write([&](MaxPathTopTree& tree) {
+        for (int v = k; v < n; v++) {
+            parent[v] = v - k;
+            tree.link(v, v - k, v);
+        }
+    });
+
+    std::atomic<bool> done { false };
+    std::atomic<int> failures { 0 };
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&, r]() {
+            std::mt19937 rng(r);
+            while (!done.load()) {
+                int u = rng() % n;
+                int v = rng() % n;
+                if (shared.same_tree(u, v) != (u % k == v % k)) {
+                    failures++;
+                }
+            }
+        });
+    }
+    std::mt19937 rng(99);
+    for (int step = 0; step < 2000; step++) {
+        int v = k + rng() % (n - k);
+        shared.write([&](MaxPathTopTree& tree) {
+            tree.cut(v, parent[v]);
+            // Any vertex of the component outside the subtree of v, which holds larger ids.
+            int target = v % k + k * (rng() % (v / k));
+            tree.link(v, target, step);
+            parent[v] = target;
+            tree.expose(v, v % k);
+            tree.deexpose(v, v % k);
+        });
+    }
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    REQUIRE(failures == 0);
+    REQUIRE(shared.same_tree(k, 2 * k));
+    REQUIRE(!shared.same_tree(1, 2));
+}
+
+TEST_CASE("Readers on a deep path", "[shared top tree]") {
+    // Linked in order, so readers find leaves deeper than they walk and splay them instead.
+    const int n = 3000;
+    SharedTopTree<AddWeightCluster, int, None> shared = SharedTopTree<AddWeightCluster, int, None>(n + 1);
+    shared.write([&](MaxPathTopTree& tree) {
+        for (int v = 0; v + 1 < n; v++) {
+            tree.link(v, v + 1, v);
+        }
+    });
+    std::atomic<int> failures { 0 };
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&, r]() {
+            std::mt19937 rng(r);
+            for (int i = 0; i < 5000; i++) {
+                int u = rng() % (n + 1);
+                int v = rng() % (n + 1);
+                if (shared.same_tree(u, v) != (u == v || (u < n && v < n))) {
+                    failures++;
+                }
+                AddWeightCluster* root = shared.find_root(u);
+                if ((root == nullptr) != (u == n)) {
+                    failures++;
+                }
+            }
+        });
+    }
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    REQUIRE(failures == 0);
+    shared.write([&](MaxPathTopTree& tree) {
+        REQUIRE(tree.expose(0, n - 1)->max_weight == n - 2);
+        tree.deexpose(0, n - 1);
+    });
+}